@@ -41,6 +41,8 @@
 #include <boost/mpl/inherit_linearly.hpp>
 #include <boost/mpl/inherit.hpp>
 #include <iostream>
+#include <algorithm>
+#include <vector>
 
 #include "concurrent.h"
 
@@ -56,6 +58,25 @@ namespace Dyninst
     public:
         typedef typename ITYPE::type interval_type;
 
+    private:
+        // Non-overlapping intervals from a bulk load, in address order.
+        // Their bounds are cached next to them, and their upper bounds are
+        // also stored in Eytzinger (BFS) order so that a search walks one
+        // small array top-down without calling low()/high().  Entries
+        // removed or displaced by later inserts are left as NULL.
+        std::vector<ITYPE*> frozen;
+        std::vector<interval_type> frozen_low;
+        std::vector<interval_type> eyt_high;   // 1-based
+        std::vector<unsigned> eyt_rank;        // index into frozen
+        size_t frozen_live;
+
+        size_t frozen_search(interval_type X, bool lower) const;
+        void frozen_layout(size_t &rank, size_t k, const std::vector<interval_type> &highs);
+        void bulk_load(std::vector<ITYPE*> &entries);
+        bool displace_frozen(ITYPE* entry);
+
+    public:
+
         IBSTree<ITYPE> overlapping_intervals;
         typedef boost::multi_index_container<ITYPE*,
                 boost::multi_index::indexed_by<
@@ -66,8 +87,13 @@ namespace Dyninst
         //typedef std::set<ITYPE*, order_by_lower<ITYPE> > interval_set;
         interval_set unique_intervals;
 
-        IBSTree_fast()
+        IBSTree_fast() : frozen_live(0)
+        {
+        }
+        template <class InputIterator>
+        IBSTree_fast(InputIterator first, InputIterator last) : frozen_live(0)
         {
+            insert(first, last);
         }
         ~IBSTree_fast()
         {
@@ -76,14 +102,19 @@ namespace Dyninst
         int size() const
         {
             dyn_rwlock::shared_lock l(rwlock);
-            return overlapping_intervals.size() + unique_intervals.size();
+            return overlapping_intervals.size() + unique_intervals.size() + frozen_live;
         }
         bool empty() const
         {
             dyn_rwlock::shared_lock l(rwlock);
-            return unique_intervals.empty() && overlapping_intervals.empty();
+            return unique_intervals.empty() && overlapping_intervals.empty() && frozen_live == 0;
         }
         void insert(ITYPE*);
+        // Inserts a batch of intervals.  An empty tree is built from the
+        // batch in one pass, sorting it once; otherwise this is the same
+        // as inserting the intervals one at a time.
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last);
         void remove(ITYPE*);
         int find(interval_type, std::set<ITYPE*> &) const;
         int find(ITYPE* I, std::set<ITYPE*>&) const;
@@ -95,6 +126,8 @@ namespace Dyninst
             dyn_rwlock::shared_lock l(tree.rwlock);
             std::copy(tree.unique_intervals.begin(), tree.unique_intervals.end(),
                       std::ostream_iterator<typename Dyninst::IBSTree_fast<ITYPE>::interval_set::value_type>(stream, "\n"));
+            for (auto f : tree.frozen)
+                if (f) stream << f << "\n";
             stream << tree.overlapping_intervals;
             return stream;
         }
@@ -110,12 +143,17 @@ namespace Dyninst
         std::set<ITYPE*> dummy;
         if(overlapping_intervals.find(entry, dummy))
         {
+            displace_frozen(entry);
             overlapping_intervals.insert(entry);
         } else { 
 	  typename interval_set::iterator lower =
 	    unique_intervals.upper_bound(entry->low());
 	  // lower.high first >= entry.low
 	  if (lower != unique_intervals.end() && (**lower == *entry)) return;
+	  size_t frozen_lower = frozen_search(entry->low(), false);
+	  if (frozen_lower < frozen.size() && frozen[frozen_lower] &&
+	      (*frozen[frozen_lower] == *entry)) return;
+	  bool displaced = displace_frozen(entry);
 	  typename interval_set::iterator upper = lower;
 	  while(upper != unique_intervals.end() &&
 		(*upper)->low() <= entry->high())
@@ -123,7 +161,7 @@ namespace Dyninst
 	      overlapping_intervals.insert(*upper);
 	      ++upper;
 	    }
-	  if(upper != lower)
+	  if(upper != lower || displaced)
 	    {
 	      unique_intervals.erase(lower, upper);
 	      overlapping_intervals.insert(entry);
@@ -134,6 +172,24 @@ namespace Dyninst
 	    }
 	}
     }
+    // Moves bulk-loaded intervals that overlap (or touch) entry into the
+    // overlapping tree, so the array only ever holds intervals that no
+    // other interval overlaps.
+    template <class ITYPE>
+    bool IBSTree_fast<ITYPE>::displace_frozen(ITYPE* entry)
+    {
+        bool displaced = false;
+        for (size_t i = frozen_search(entry->low(), false);
+             i < frozen.size() && frozen_low[i] <= entry->high(); ++i)
+        {
+            if (!frozen[i]) continue;
+            overlapping_intervals.insert(frozen[i]);
+            frozen[i] = NULL;
+            --frozen_live;
+            displaced = true;
+        }
+        return displaced;
+    }
     template <class ITYPE>
     void IBSTree_fast<ITYPE>::remove(ITYPE* entry)
     {
@@ -142,6 +198,12 @@ namespace Dyninst
         overlapping_intervals.remove(entry);
         typename interval_set::iterator found = unique_intervals.find(entry->high());
         if(found != unique_intervals.end() && *found == entry) unique_intervals.erase(found);
+
+        size_t r = frozen_search(entry->high(), true);
+        if(r < frozen.size() && frozen[r] == entry) {
+            frozen[r] = NULL;
+            --frozen_live;
+        }
     }
     template<class ITYPE>
     int IBSTree_fast<ITYPE>::find(interval_type X, std::set<ITYPE*> &results) const
@@ -149,6 +211,15 @@ namespace Dyninst
       dyn_rwlock::shared_lock l(rwlock);
       int num_old_results = results.size();
 
+      // Nothing overlaps a bulk-loaded interval, so a hit there is the
+      // only answer and the overlapping tree need not be searched
+      size_t r = frozen_search(X, false);
+      if(r < frozen.size() && frozen[r] && frozen_low[r] <= X)
+      {
+        results.insert(frozen[r]);
+        return results.size() - num_old_results;
+      }
+
       int num_overlapping = overlapping_intervals.find(X, results);
       if(num_overlapping > 0) return num_overlapping;
 
@@ -174,6 +245,11 @@ namespace Dyninst
             results.insert(*ub);
             ++ub;
         }
+        for(size_t r = frozen_search(I->low(), false);
+            r < frozen.size() && frozen_low[r] < I->high(); ++r)
+        {
+            if(frozen[r]) results.insert(frozen[r]);
+        }
         int result = results.size() - num_old_results;
 	return result;
     }
@@ -184,18 +260,21 @@ namespace Dyninst
         ITYPE* overlapping_ub = overlapping_intervals.successor(X);
 
         typename interval_set::const_iterator unique_ub = unique_intervals.upper_bound(X);
-        if(overlapping_ub && (unique_ub != unique_intervals.end()))
-        {
-            results.insert(overlapping_ub->low() < (*unique_ub)->low() ? overlapping_ub : *unique_ub);
-        }
-        else if(overlapping_ub)
+        ITYPE* best = overlapping_ub;
+        if(unique_ub != unique_intervals.end() &&
+           (!best || (*unique_ub)->low() < best->low()))
         {
-            results.insert(overlapping_ub);
+            best = *unique_ub;
         }
-        else if(unique_ub != unique_intervals.end())
+
+        size_t r = frozen_search(X, false);
+        while(r < frozen.size() && !frozen[r]) ++r;
+        if(r < frozen.size() && (!best || frozen_low[r] < best->low()))
         {
-            results.insert(*unique_ub);
+            best = frozen[r];
         }
+
+        if(best) results.insert(best);
     }
     template <typename ITYPE>
     ITYPE* IBSTree_fast<ITYPE>::successor(interval_type X) const
@@ -212,6 +291,118 @@ namespace Dyninst
         dyn_rwlock::unique_lock l(rwlock);
         overlapping_intervals.clear();
         unique_intervals.clear();
+        frozen.clear();
+        frozen_low.clear();
+        eyt_high.clear();
+        eyt_rank.clear();
+        frozen_live = 0;
+    }
+
+    // Returns the index in frozen of the first interval whose upper bound
+    // is >= X (lower) or > X, or frozen.size() if there is none.
+    template <typename ITYPE>
+    size_t IBSTree_fast<ITYPE>::frozen_search(interval_type X, bool lower) const
+    {
+        size_t n = frozen.size();
+        size_t k = 1;
+        if(lower) {
+            while(k <= n) k = 2 * k + (eyt_high[k] < X);
+        } else {
+            while(k <= n) k = 2 * k + (eyt_high[k] <= X);
+        }
+        // k encodes the path taken; the answer is where the last left
+        // turn was made, so drop the trailing right turns and that one.
+        while(k & 1) k >>= 1;
+        k >>= 1;
+        return k ? eyt_rank[k] : n;
+    }
+
+    template <typename ITYPE>
+    void IBSTree_fast<ITYPE>::frozen_layout(size_t &rank, size_t k,
+                                            const std::vector<interval_type> &highs)
+    {
+        if(k > frozen.size()) return;
+        frozen_layout(rank, 2 * k, highs);
+        eyt_high[k] = highs[rank];
+        eyt_rank[k] = rank;
+        ++rank;
+        frozen_layout(rank, 2 * k + 1, highs);
+    }
+
+    template <typename ITYPE>
+    template <class InputIterator>
+    void IBSTree_fast<ITYPE>::insert(InputIterator first, InputIterator last)
+    {
+        std::vector<ITYPE*> entries(first, last);
+        {
+            dyn_rwlock::unique_lock l(rwlock);
+            if(unique_intervals.empty() && overlapping_intervals.empty() && frozen.empty()) {
+                bulk_load(entries);
+                return;
+            }
+        }
+        for(auto e : entries) insert(e);
+    }
+
+    // Called with the write lock held on an empty tree
+    template <typename ITYPE>
+    void IBSTree_fast<ITYPE>::bulk_load(std::vector<ITYPE*> &entries)
+    {
+        struct bounds {
+            interval_type low, high;
+            ITYPE* entry;
+            bool operator<(const bounds &o) const {
+                return low < o.low || (low == o.low && high < o.high);
+            }
+        };
+        std::vector<bounds> sorted;
+        sorted.reserve(entries.size());
+        for(auto e : entries) {
+            bounds b = { e->low(), e->high(), e };
+            sorted.push_back(b);
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        // Drop repeats of an interval, as insert() would
+        size_t n = 0;
+        for(size_t i = 0; i < sorted.size(); ++i) {
+            if(n > 0 && sorted[n-1].low == sorted[i].low && sorted[n-1].high == sorted[i].high &&
+               (sorted[n-1].entry == sorted[i].entry || *sorted[n-1].entry == *sorted[i].entry))
+                continue;
+            sorted[n++] = sorted[i];
+        }
+        sorted.resize(n);
+
+        // Runs of mutually overlapping intervals go to the overlapping
+        // tree; an interval that overlaps nothing goes to the array.  An
+        // empty interval at the end of the previous one would share its
+        // upper bound, so it counts as overlapping too.
+        std::vector<interval_type> highs;
+        std::vector<ITYPE*> overlapping;
+        for(size_t i = 0; i < n; ) {
+            interval_type max_high = sorted[i].high;
+            size_t j = i + 1;
+            while(j < n && (sorted[j].low < max_high || sorted[j].high <= max_high)) {
+                if(sorted[j].high > max_high) max_high = sorted[j].high;
+                ++j;
+            }
+            if(j - i == 1) {
+                frozen.push_back(sorted[i].entry);
+                frozen_low.push_back(sorted[i].low);
+                highs.push_back(sorted[i].high);
+            } else {
+                for(size_t k = i; k < j; ++k)
+                    overlapping.push_back(sorted[k].entry);
+            }
+            i = j;
+        }
+        overlapping_intervals.insert(overlapping.begin(), overlapping.end());
+        frozen_live = frozen.size();
+
+        eyt_high.resize(frozen.size() + 1);
+        eyt_rank.resize(frozen.size() + 1);
+        size_t rank = 0;
+        frozen_layout(rank, 1, highs);
     }
 
 }
@@ -42,8 +42,10 @@
 #include "concurrent.h"
 
 #include <set>
+#include <vector>
 #include <limits>
 #include <iostream>
+#include <algorithm>
 
 /** Template class for Interval Binary Search Tree. The implementation is
   * based on a red-black tree (derived from our codeRange implementation)
@@ -217,6 +219,17 @@ private:
     /** Tree-balancing algorithm on insertion **/
     void insertFixup(IBSNode<ITYPE> *x);
 
+    /** Build a balanced subtree over the sorted endpoints [lo, hi);
+        nodes at redDepth (the partial bottom level) are red **/
+    IBSNode<ITYPE>* buildBalanced(const std::vector<interval_type> &vals,
+                                  size_t lo, size_t hi, int depth, int redDepth,
+                                  IBSNode<ITYPE> *parent);
+
+    /** addLeft and addRight for an interval whose endpoints are both
+        in the tree; the rightUp/leftUp bounds are tracked on the way
+        down instead of walking back up from each node **/
+    void markInterval(ITYPE *I);
+
     /** Finds the precessor of the node; this node will have its value
         copied to the target node of a deletion and will itself be deleted **/
     //IBSNode* treePredecessor(IBSNode *);
@@ -262,6 +275,15 @@ public:
         //stats_.add("remove",TimerStat);
     }     
 
+    template <class InputIterator>
+    IBSTree(InputIterator first, InputIterator last) :
+        nil(new IBSNode<ITYPE>),
+        treeSize(0),
+        root(nil)
+    {
+        insert(first, last);
+    }
+
     ~IBSTree() {
         destroy(root);
         delete nil;
@@ -290,6 +312,13 @@ public:
 
     void insert(ITYPE *);
 
+    /** Insert a batch of intervals. An empty tree gets all of the
+        endpoints at once, sorted and already balanced, so marking the
+        intervals needs no rotations; otherwise this is the same as
+        inserting them one at a time. **/
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last);
+
     void remove(ITYPE *);
 
     /** Find all intervals that overlap the provided point. Returns
@@ -797,6 +826,103 @@ void IBSTree<ITYPE>::insert(ITYPE *range)
     //stats_.stopTimer("insert");
 }
 
+template<class ITYPE>
+template <class InputIterator>
+void IBSTree<ITYPE>::insert(InputIterator first, InputIterator last)
+{
+    std::vector<ITYPE *> entries(first, last);
+    {
+        dyn_rwlock::unique_lock l(rwlock);
+        if(root == nil && !entries.empty()) {
+            std::vector<interval_type> vals;
+            vals.reserve(2 * entries.size());
+            for(auto e : entries) {
+                vals.push_back(e->low());
+                vals.push_back(e->high());
+            }
+            std::sort(vals.begin(), vals.end());
+            vals.erase(std::unique(vals.begin(), vals.end()), vals.end());
+
+            // Levels [0, redDepth) are full and black; whatever is
+            // left of the bottom level is red
+            int redDepth = 0;
+            while(((size_t) 2 << redDepth) - 1 <= vals.size())
+                ++redDepth;
+            root = buildBalanced(vals, 0, vals.size(), 0, redDepth, NULL);
+            treeSize.store(vals.size());
+
+            for(auto e : entries)
+                markInterval(e);
+            return;
+        }
+    }
+    for(auto e : entries) insert(e);
+}
+
+template<class ITYPE>
+IBSNode<ITYPE>*
+IBSTree<ITYPE>::buildBalanced(const std::vector<interval_type> &vals,
+                              size_t lo, size_t hi, int depth, int redDepth,
+                              IBSNode<ITYPE> *parent)
+{
+    if(lo >= hi) return nil;
+    size_t mid = lo + (hi - lo) / 2;
+    IBSNode<ITYPE> *n = new IBSNode<ITYPE>(vals[mid], nil);
+    n->color = (depth >= redDepth) ? IBS::TREE_RED : IBS::TREE_BLACK;
+    n->parent = parent;
+    n->left = buildBalanced(vals, lo, mid, depth + 1, redDepth, n);
+    n->right = buildBalanced(vals, mid + 1, hi, depth + 1, redDepth, n);
+    return n;
+}
+
+template<class ITYPE>
+void IBSTree<ITYPE>::markInterval(ITYPE *I)
+{
+    interval_type ilow = I->low();
+    interval_type ihigh = I->high();
+
+    // Same marks as addLeft
+    interval_type up = std::numeric_limits<interval_type>::max();
+    IBSNode<ITYPE> *R = root;
+    while(R != nil) {
+        interval_type rval = R->value();
+        if(rval == ilow) {
+            if(up <= ihigh) R->greater.insert(I);
+            R->equal.insert(I);
+            break;
+        }
+        else if(rval < ilow) {
+            R = R->right;
+        }
+        else {
+            if(rval < ihigh) R->equal.insert(I);
+            if(up <= ihigh) R->greater.insert(I);
+            up = rval;
+            R = R->left;
+        }
+    }
+
+    // Same marks as addRight
+    interval_type down = std::numeric_limits<interval_type>::min();
+    R = root;
+    while(R != nil) {
+        interval_type rval = R->value();
+        if(rval == ihigh) {
+            if(down >= ilow) R->less.insert(I);
+            break;
+        }
+        else if(rval < ihigh) {
+            if(rval > ilow) R->equal.insert(I);
+            if(down >= ilow) R->less.insert(I);
+            down = rval;
+            R = R->right;
+        }
+        else {
+            R = R->left;
+        }
+    }
+}
+
 template<class ITYPE>
 void IBSTree<ITYPE>::remove(ITYPE * range)
 {
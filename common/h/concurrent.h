@@ -33,6 +33,7 @@
 
 #include "util.h"
 #include <memory>
+#include <stdint.h>
 #include <boost/atomic.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
@@ -153,6 +154,64 @@ public:
     using base::end;
 };
 
+// A dyn_c_hash_map split into 2^StripeBits independent maps by key hash.
+// Besides its bucket locks, a tbb::concurrent_hash_map keeps an element
+// count and a bucket array that every insertion from every thread
+// touches; striping spreads that traffic over several maps.  Accessors
+// are those of the underlying dyn_c_hash_map.
+template<typename K, typename V, unsigned StripeBits = 4>
+class dyn_c_striped_hash_map {
+    typedef dyn_c_hash_map<K,V> stripe_t;
+    static const unsigned NumStripes = 1U << StripeBits;
+public:
+    typedef typename stripe_t::value_type value_type;
+    typedef typename stripe_t::mapped_type mapped_type;
+    typedef typename stripe_t::key_type key_type;
+    typedef typename stripe_t::const_accessor const_accessor;
+    typedef typename stripe_t::accessor accessor;
+
+    bool find(const_accessor& ca, const K& k) const { return stripe(k).find(ca, k); }
+    bool find(accessor& a, const K& k) { return stripe(k).find(a, k); }
+
+    int contains(const K& k) { return stripe(k).contains(k); }
+
+    bool insert(const_accessor& ca, const K& k) { return stripe(k).insert(ca, k); }
+    bool insert(accessor& a, const K& k) { return stripe(k).insert(a, k); }
+    bool insert(const_accessor& ca, const value_type& e) { return stripe(e.first).insert(ca, e); }
+    bool insert(accessor& a, const value_type& e) { return stripe(e.first).insert(a, e); }
+    bool insert(const value_type& e) { return stripe(e.first).insert(e); }
+
+    bool erase(const_accessor& ca) { return stripe(ca->first).erase(ca); }
+    bool erase(accessor& a) { return stripe(a->first).erase(a); }
+    bool erase(const K& k) { return stripe(k).erase(k); }
+
+    int size() const {
+        int n = 0;
+        for (unsigned i = 0; i < NumStripes; ++i) n += stripes[i].size();
+        return n;
+    }
+
+    void rehash(int n = 0) {
+        for (unsigned i = 0; i < NumStripes; ++i) stripes[i].rehash(n / NumStripes);
+    }
+
+    void clear() {
+        for (unsigned i = 0; i < NumStripes; ++i) stripes[i].clear();
+    }
+
+private:
+    // Fibonacci hashing on top of the key hash: the stripe comes from the
+    // high bits, leaving the low bits to pick buckets within the stripe.
+    static unsigned index(const K& k) {
+        uint64_t h = tbb::tbb_hash_compare<K>().hash(k);
+        return (unsigned)((h * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - StripeBits));
+    }
+    stripe_t& stripe(const K& k) { return stripes[index(k)]; }
+    const stripe_t& stripe(const K& k) const { return stripes[index(k)]; }
+
+    stripe_t stripes[NumStripes];
+};
+
 template<typename T>
 using dyn_c_vector = tbb::concurrent_vector<T, std::allocator<T>>;
 
@@ -29,8 +29,11 @@
  */
 
 #include <vector>
+#include <list>
+#include <utility>
 #include <assert.h>
 #include "dyntypes.h"
+#include "concurrent.h"
 
 #if !defined LRUCache_h_
 #define LRUCache_h_
@@ -218,6 +221,7 @@ class LRUCache {
          int list_elem = map_elems[result];
          list_set_keyval(list_elem, key, value);
          list_move_to_front(list_elem);
+         return;
       }
       
       int elem_to_insert;
@@ -250,4 +254,91 @@ class LRUCache {
    }
 };
 
+//A thread-safe LRU cache.  Keys are spread over independently locked
+// shards, each with its own LRU list, so threads looking up different
+// keys rarely contend.  Unlike LRUCache this allocates as it goes, so it
+// must not be used under a signal handler.
+template<class K, class V, class H = std::hash<K> >
+class ConcurrentLRUCache {
+ private:
+   static const unsigned num_shards = 16;
+
+   typedef std::list<std::pair<K, V> > lru_list;
+   struct Shard {
+      Dyninst::dyn_mutex lock;
+      lru_list lru; //Most recently used at the front
+      dyn_hash_map<K, typename lru_list::iterator, H> index;
+   };
+
+   Shard shards[num_shards];
+   size_t shard_capacity;
+   H hash_func;
+   boost::atomic<unsigned long> hits;
+   boost::atomic<unsigned long> misses;
+
+   Shard &shard(const K &key) {
+      size_t h = hash_func(key);
+      return shards[(h ^ (h >> 16)) % num_shards];
+   }
+
+ public:
+   //A capacity of 0 disables the cache; every lookup misses.
+   ConcurrentLRUCache(size_t capacity) :
+      shard_capacity((capacity + num_shards - 1) / num_shards),
+      hits(0),
+      misses(0)
+   {
+   }
+
+   bool lookup(const K &key, V &value)
+   {
+      Shard &s = shard(key);
+      Dyninst::dyn_mutex::unique_lock l(s.lock);
+      typename dyn_hash_map<K, typename lru_list::iterator, H>::iterator i =
+         s.index.find(key);
+      if (i == s.index.end()) {
+         misses.fetch_add(1, boost::memory_order_relaxed);
+         return false;
+      }
+      s.lru.splice(s.lru.begin(), s.lru, i->second);
+      value = i->second->second;
+      hits.fetch_add(1, boost::memory_order_relaxed);
+      return true;
+   }
+
+   void insert(const K &key, const V &value)
+   {
+      if (!shard_capacity)
+         return;
+      Shard &s = shard(key);
+      Dyninst::dyn_mutex::unique_lock l(s.lock);
+      typename dyn_hash_map<K, typename lru_list::iterator, H>::iterator i =
+         s.index.find(key);
+      if (i != s.index.end()) {
+         i->second->second = value;
+         s.lru.splice(s.lru.begin(), s.lru, i->second);
+         return;
+      }
+      if (s.index.size() >= shard_capacity) {
+         s.index.erase(s.lru.back().first);
+         s.lru.pop_back();
+      }
+      s.lru.push_front(std::make_pair(key, value));
+      s.index[key] = s.lru.begin();
+   }
+
+   void clear()
+   {
+      for (unsigned i = 0; i < num_shards; i++) {
+         Dyninst::dyn_mutex::unique_lock l(shards[i].lock);
+         shards[i].index.clear();
+         shards[i].lru.clear();
+      }
+   }
+
+   size_t capacity() const { return shard_capacity * num_shards; }
+   unsigned long numHits() const { return hits.load(); }
+   unsigned long numMisses() const { return misses.load(); }
+};
+
 #endif
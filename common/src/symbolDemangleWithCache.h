@@ -31,3 +31,6 @@
 #include <string>
 
 std::string const& symbol_demangle_with_cache(const std::string &symName, bool includeParams);
+
+// Hit and miss counts of the shared demangling cache
+void symbol_demangle_cache_stats(unsigned long &hits, unsigned long &misses);
@@ -38,6 +38,7 @@
 #include "Operand.h"
 #include "Absloc.h"
 #include "util.h"
+#include "concurrent.h"
 
 class int_function;
 class BPatch_function;
@@ -124,9 +125,56 @@ class AbsRegionConverter {
   bool stackAnalysisEnabled_;
 };
 
+// Converted assignments shared by every AssignmentConverter working on
+// one CodeObject, and safe to use from several threads.  An assignment
+// names the block it was converted in, and blocks can be split while
+// parsing, so entries are keyed by function, block, and address; stack
+// heights change when a function's CFG does, so they are also keyed by
+// the function's cfgVersion().  Once maxEntries conversions are cached,
+// new ones are no longer added.
+class AssignmentCache {
+ public:
+  static const unsigned long defaultMaxEntries = 1UL << 20;
+
+  DATAFLOW_EXPORT AssignmentCache(unsigned long maxEntries = defaultMaxEntries) :
+    maxEntries_(maxEntries), entries_(0), hits_(0), misses_(0) {}
+
+  DATAFLOW_EXPORT bool find(ParseAPI::Function *func,
+                            ParseAPI::Block *block,
+                            Address addr,
+                            bool stack,
+                            std::vector<Assignment::Ptr> &assignments);
+  DATAFLOW_EXPORT void insert(ParseAPI::Function *func,
+                              ParseAPI::Block *block,
+                              Address addr,
+                              bool stack,
+                              const std::vector<Assignment::Ptr> &assignments);
+
+  DATAFLOW_EXPORT unsigned long numHits() const { return hits_.load(); }
+  DATAFLOW_EXPORT unsigned long numMisses() const { return misses_.load(); }
+
+ private:
+  struct Entry {
+    ParseAPI::Function *func;
+    ParseAPI::Block *block;
+    bool stack;
+    unsigned version;
+    std::vector<Assignment::Ptr> assignments;
+  };
+  dyn_c_hash_map<Address, std::vector<Entry> > cache_;
+  unsigned long maxEntries_;
+  boost::atomic<unsigned long> entries_;
+  boost::atomic<unsigned long> hits_;
+  boost::atomic<unsigned long> misses_;
+};
+
 class AssignmentConverter {
  public:  
- DATAFLOW_EXPORT AssignmentConverter(bool cache, bool stack) : cacheEnabled_(cache), aConverter(false, stack) {};
+ DATAFLOW_EXPORT AssignmentConverter(bool cache, bool stack) : cacheEnabled_(cache), stack_(stack), sharedCache_(NULL), aConverter(false, stack) {};
+
+  // Also look up and record conversions in a cache shared with other
+  // converters, normally CodeObject::assignmentCache().  May be NULL.
+  DATAFLOW_EXPORT void setSharedCache(AssignmentCache *c) { sharedCache_ = c; }
 
   DATAFLOW_EXPORT void convert(const InstructionAPI::Instruction &insn,
                                const Address &addr,
@@ -157,6 +205,8 @@ class AssignmentConverter {
 
   FuncCache cache_;
   bool cacheEnabled_;
+  bool stack_;
+  AssignmentCache *sharedCache_;
 
   AbsRegionConverter aConverter;
 };
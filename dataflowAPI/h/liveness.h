@@ -42,6 +42,7 @@
 #include "ABI.h"
 #include <map>
 #include <set>
+#include <boost/shared_ptr.hpp>
 
 
 using namespace Dyninst;
@@ -51,20 +52,23 @@ struct livenessData{
 	bitArray in, out, use, def;
 };
 
+struct FuncLiveness;
+
 class DATAFLOW_EXPORT LivenessAnalyzer{
-	std::map<ParseAPI::Block*, livenessData> blockLiveInfo;
-	std::map<ParseAPI::Function*, bool> liveFuncCalculated;
-        std::map<ParseAPI::Function*, bitArray> funcRegsDefined;
+	// Per-function results, keyed by the function they were computed for
+	std::map<ParseAPI::Function*, boost::shared_ptr<FuncLiveness> > funcLiveInfo;
 	InstructionCache cachedLivenessInfo;
 
-	const bitArray& getLivenessIn(ParseAPI::Block *block);
-	const bitArray& getLivenessOut(ParseAPI::Block *block, bitArray &allRegsDefined);
-	void processEdgeLiveness(ParseAPI::Edge* e, livenessData& data, ParseAPI::Block* block, const bitArray& allRegsDefined);
-	
-	void summarizeBlockLivenessInfo(ParseAPI::Function* func, ParseAPI::Block *block, bitArray &allRegsDefined);
-	bool updateBlockLivenessInfo(ParseAPI::Block *block, bitArray &allRegsDefined);
+	FuncLiveness *getFuncLiveness(ParseAPI::Function *func);
+	bool getLivenessIn(ParseAPI::Function *func, ParseAPI::Block *block, bitArray &in);
+	bool getLivenessOut(ParseAPI::Function *func, ParseAPI::Block *block, bitArray &out);
+
+	void analyzeFunc(ParseAPI::Function *func, ABI *a, FuncLiveness &fl, InstructionCache *cache);
+	void summarizeBlockLivenessInfo(ParseAPI::Function *func, ParseAPI::Block *block, ABI *a,
+					FuncLiveness &fl, unsigned idx, InstructionCache *cache);
 	
 	ReadWriteInfo calcRWSets(Instruction curInsn, ParseAPI::Block *blk, Address a);
+	ReadWriteInfo calcRWSets(Instruction curInsn, ParseAPI::Block *blk, Address a, ABI *abi);
 
 	void* getPtrToInstruction(ParseAPI::Block *block, Address addr) const;	
 	bool isExitBlock(ParseAPI::Block *block);
@@ -78,6 +82,9 @@ public:
 	typedef enum {Invalid_Location} ErrorType;
 	LivenessAnalyzer(int w);
 	void analyze(ParseAPI::Function *func);
+	// Analyzes every function of the CodeObject that is not already
+	// up to date, in parallel.
+	void analyze(ParseAPI::CodeObject *co);
 
 	template <class OutputIterator>
 	bool query(ParseAPI::Location loc, Type type, OutputIterator outIter){
@@ -0,0 +1,116 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _REG_BIT_SET_
+#define _REG_BIT_SET_
+
+#include <assert.h>
+#include "bitArray.h"
+
+// A register set whose width is fixed at compile time, for the inner
+// loops of dataflow analyses.  bitArray (boost::dynamic_bitset) keeps its
+// words on the heap and checks sizes on every operation; here the words
+// are inline and every operation is a loop over a constant word count,
+// which compilers unroll and vectorize.  Bits are numbered as in ABI's
+// register index map.
+template <unsigned Words>
+class FixedRegBitSet {
+ public:
+   typedef bitArray::block_type word_t;
+   static const unsigned word_bits = sizeof(word_t) * 8;
+   static const unsigned capacity = Words * word_bits;
+
+   FixedRegBitSet() { reset(); }
+
+   explicit FixedRegBitSet(const bitArray &b) {
+      assert(b.num_blocks() <= Words);
+      reset();
+      boost::to_block_range(b, words);
+   }
+
+   void reset() {
+      for (unsigned i = 0; i < Words; i++) words[i] = 0;
+   }
+
+   bool test(unsigned i) const {
+      return (words[i / word_bits] >> (i % word_bits)) & 1;
+   }
+
+   void set(unsigned i) {
+      words[i / word_bits] |= (word_t) 1 << (i % word_bits);
+   }
+
+   FixedRegBitSet &operator|=(const FixedRegBitSet &o) {
+      for (unsigned i = 0; i < Words; i++) words[i] |= o.words[i];
+      return *this;
+   }
+
+   FixedRegBitSet &operator&=(const FixedRegBitSet &o) {
+      for (unsigned i = 0; i < Words; i++) words[i] &= o.words[i];
+      return *this;
+   }
+
+   // this = a | (b & ~c), the transfer function of a backwards
+   // may-analysis such as liveness: IN = USE | (OUT - DEF)
+   void setOrAndNot(const FixedRegBitSet &a, const FixedRegBitSet &b,
+                    const FixedRegBitSet &c) {
+      for (unsigned i = 0; i < Words; i++)
+         words[i] = a.words[i] | (b.words[i] & ~c.words[i]);
+   }
+
+   bool operator==(const FixedRegBitSet &o) const {
+      word_t diff = 0;
+      for (unsigned i = 0; i < Words; i++) diff |= words[i] ^ o.words[i];
+      return diff == 0;
+   }
+
+   bool operator!=(const FixedRegBitSet &o) const { return !(*this == o); }
+
+   // Copies into a bitArray of the given size, which must be at most
+   // capacity.
+   void toBitArray(bitArray &b, unsigned size) const {
+      b.resize(size);
+      boost::from_block_range(words, words + b.num_blocks(), b);
+   }
+
+ private:
+   word_t words[Words];
+};
+
+// Sized for the largest register index map of the architecture we are
+// built for: 167 registers on x86_64 (including the AVX-512 and mask
+// registers), 171 on POWER, and 100 on aarch64.
+#if defined(arch_aarch64)
+typedef FixedRegBitSet<128 / (sizeof(bitArray::block_type) * 8)> RegBitSet;
+#else
+typedef FixedRegBitSet<192 / (sizeof(bitArray::block_type) * 8)> RegBitSet;
+#endif
+
+#endif
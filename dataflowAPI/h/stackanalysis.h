@@ -35,6 +35,7 @@
 #include <values.h>
 #endif
 
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <set>
@@ -65,6 +66,7 @@ namespace Dyninst {
       class Function;
       class Block;
       class Edge;
+      class CodeObject;
    };
    namespace InstructionAPI {
       class Instruction;
@@ -492,6 +494,9 @@ public:
    typedef std::map<ParseAPI::Block *, std::map<Offset, TransferSet> >
       CallEffects;
 
+   // Function summaries keyed by function entry address
+   typedef std::map<Address, TransferSet> FunctionSummaries;
+
    DATAFLOW_EXPORT StackAnalysis();
    DATAFLOW_EXPORT StackAnalysis(ParseAPI::Function *f);
    DATAFLOW_EXPORT StackAnalysis(ParseAPI::Function *f,
@@ -515,6 +520,20 @@ public:
    DATAFLOW_EXPORT bool canGetFunctionSummary();
    DATAFLOW_EXPORT bool getFunctionSummary(TransferSet &summary);
 
+   // Summarizes every function of co, callees before callers.  Functions
+   // whose callees are all summarized are analyzed in parallel, and
+   // mutually recursive functions are iterated to a fixed point.  Each
+   // analysis sees only the summaries of its own callees.  Summaries
+   // already in summaries, e.g. from readSummaries, are reused as is.
+   DATAFLOW_EXPORT static void summarizeFunctions(ParseAPI::CodeObject *co,
+      FunctionSummaries &summaries);
+   // Save and restore a summary table.  Summaries that refer to a
+   // particular function's stack frame are not written.
+   DATAFLOW_EXPORT static bool writeSummaries(std::ostream &out,
+      const FunctionSummaries &summaries);
+   DATAFLOW_EXPORT static bool readSummaries(std::istream &in,
+      FunctionSummaries &summaries);
+
    DATAFLOW_EXPORT void debug();
    DATAFLOW_EXPORT void clearAnnotation();
 
@@ -527,6 +546,7 @@ private:
 
    bool analyze();
    bool genInsnEffects();
+   void dropStaleAnnotations();
    void summarizeBlocks(bool verbose = false);
    void summarize();
 
@@ -154,6 +154,16 @@ class BPATCH_DLL_EXPORT BPatch {
     /* How far through the CFG do we follow calls? */
     int livenessAnalysisDepth_;
 
+    /* If true, DYNINSTuserMessage and dynamic call-site reports go
+       through shared-memory rings instead of stopping the mutatee.
+       Defaults to false. */
+    bool asyncUserMessages_;
+
+    /* If true, base trampolines use liveness at the point and the
+       registers the snippets define to save only registers that are
+       both live and clobbered.  Defaults to false. */
+    bool minimalTrampSaves_;
+
     /* If true, override requests to block while waiting for events,
        polling instead */
     bool asyncActive;
@@ -247,6 +257,7 @@ public:
 
     void registerDynamicCallsiteEvent(BPatch_process *process, Dyninst::Address callTarget,
            Dyninst::Address callAddr);
+    void deliverAsyncCallsiteEvents();
 
     void registerStopThreadCallback(BPatchStopThreadCallback stopCB);
     int getStopThreadCallbackID(BPatchStopThreadCallback stopCB);
@@ -338,6 +349,16 @@ public:
     
                int livenessAnalysisDepth();
 
+    // BPatch::asyncUserMessagesOn:
+    // returns whether user messages are delivered without stopping the mutatee
+
+    bool asyncUserMessagesOn();
+
+    // BPatch::minimalTrampSavesOn:
+    // returns whether base trampolines save only live, clobbered registers
+
+    bool minimalTrampSavesOn();
+
 
     //  User-specified callback functions...
 
@@ -542,6 +563,25 @@ public:
     
                  void  setLivenessAnalysisDepth(int x);
 
+    // BPatch::setAsyncUserMessages:
+    // Deliver DYNINSTuserMessage and dynamic call-site events through
+    // shared-memory rings drained by a Dyninst thread, so the mutatee
+    // does not stop for each one.  User event callbacks then run on
+    // that thread; dynamic call-site callbacks still run from
+    // pollForStatusChange/waitForStatusChange.  Affects processes
+    // created or attached afterwards.
+
+    void setAsyncUserMessages(bool x);
+
+    // BPatch::setMinimalTrampSaves:
+    // Save only registers that are live at the instrumentation point
+    // and written by the trampoline, down to individual vector
+    // registers, instead of a conservative set.  Where the trampoline
+    // cannot prove what it writes it falls back to saving every live
+    // register.  Affects instrumentation generated afterwards.
+
+    void setMinimalTrampSaves(bool x);
+
     // BPatch::processCreate:
     // Create a new mutatee process
     
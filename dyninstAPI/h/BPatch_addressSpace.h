@@ -153,6 +153,7 @@ class BPATCH_DLL_EXPORT BPatch_addressSpace {
   friend class BPatch_funcCallExpr;
   friend class BPatch_eventMailbox;
   friend class BPatch_instruction;
+  friend class BPatch_counterIncrementExpr;
   friend Dyninst::PatchAPI::PatchMgrPtr Dyninst::PatchAPI::convert(const BPatch_addressSpace *);
   
  public:
@@ -187,6 +188,8 @@ class BPATCH_DLL_EXPORT BPatch_addressSpace {
   
   std::vector<BPatch_register> registers_;
 
+  unsigned numCounters_;
+
  protected:
   virtual void getAS(std::vector<AddressSpace *> &as) = 0;
   
@@ -371,6 +374,14 @@ class BPATCH_DLL_EXPORT BPatch_addressSpace {
   
   bool free(BPatch_variableExpr &ptr);
 
+  //  BPatch_addressSpace::allocateCounters
+  //
+  //  Reserve n of the runtime library's per-thread counters, to be
+  //  incremented with BPatch_counterIncrementExpr.  Returns the index
+  //  of the first, or -1 if there are not enough left.
+
+  int allocateCounters(unsigned n);
+
   // BPatch_addressSpace::createVariable
   // 
   // Wrap an existing piece of allocated memory with a BPatch_variableExpr.
@@ -60,6 +60,7 @@ class BPatch_instpMap;
 class func_instance;
 class rpcMgr;
 class HybridAnalysis;
+class UserMessageRing;
 struct batchInsertionRecord;
 
 typedef enum {
@@ -191,6 +192,11 @@ class BPATCH_DLL_EXPORT BPatch_process : public BPatch_addressSpace {
 
   HybridAnalysis *hybridAnalysis_;
 
+  // Non-NULL when user messages arrive through shared memory
+  UserMessageRing *msgRing_;
+  void startMessageRing();
+  void stopMessageRing();
+
   static int oneTimeCodeCallbackDispatch(PCProcess *theProc,
 					 unsigned /* rpcid */, 
 					 void *userData,
@@ -268,6 +274,14 @@ class BPATCH_DLL_EXPORT BPatch_process : public BPatch_addressSpace {
 
   int getAddressWidth();
 
+  //  BPatch_process::readCounters
+  //
+  //  Sum counters [first, first + count) from BPatch_addressSpace::
+  //  allocateCounters over every thread of the mutatee into totals
+
+  bool readCounters(unsigned first, unsigned count,
+                    std::vector<unsigned long long> &totals);
+
   //  BPatch_process::stopExecution
   //  
   //  Stop the mutatee process
@@ -522,6 +522,19 @@ class BPATCH_DLL_EXPORT BPatch_tidExpr : public BPatch_snippet {
   BPatch_tidExpr(BPatch_process *proc);
 };
 
+class BPATCH_DLL_EXPORT BPatch_counterIncrementExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_counterIncrementExpr::BPatch_counterIncrementExpr
+  //
+  // Add amount to the executing thread's copy of a counter from
+  // BPatch_addressSpace::allocateCounters; each thread has its own,
+  // so no atomic operations are needed.  Read the totals with
+  // BPatch_process::readCounters.
+  BPatch_counterIncrementExpr(BPatch_addressSpace &addSpace,
+                              unsigned counter, long amount = 1);
+};
+
 class BPatch_instruction;
 
 typedef enum {
@@ -57,6 +57,8 @@
 
 #include "common/h/dyntypes.h"
 #include <list>
+#include <vector>
+#include <utility>
 #include "dyninstAPI/src/codegen.h"
 
 class codeGen;
@@ -124,16 +126,29 @@ class CodeBuffer {
                     codeGen &gen,
                     int &shift,
                     bool &regenerate);
+      // Relaxation support: can our last output be used at addr as is,
+      // and if not, regenerate it off to the side at addr.
+      bool reusable(CodeBuffer *buf, Address addr);
+      bool regenerate(CodeBuffer *buf, const codeGen &templ, Address addr);
       bool extractTrackers(CodeTracker *t);
 
      private:
       void addTracker(TrackerElement *tracker);
+      // Where the patch lands if this element is placed at base
+      Address patchAddr(Address base) const { return base + buffer_.size(); }
 
       Address addr_;
       unsigned size_;
       Buffer buffer_;
       Patch *patch_;
       unsigned labelID_;
+
+      // What we generated last time, and the label addresses the
+      // patch looked up to do it
+      Buffer code_;
+      Address codeAddr_;
+      typedef std::vector<std::pair<unsigned, Address> > LabelDeps;
+      LabelDeps deps_;
       // Here the Offset is an offset within the buffer, starting at 0.
       typedef std::map<Offset, TrackerElement *> Trackers;
       Trackers trackers_;
@@ -170,6 +185,12 @@ class CodeBuffer {
   private:
 
    BufferElement &current();
+   Address predictedAddrInt(Label &label);
+
+   // Iterate to a fixed point by placing every element at the address
+   // the previous pass's sizes give it; only elements whose output
+   // could have changed are regenerated, relative patches in parallel.
+   bool relax(Address baseAddr, bool &converged);
 
    typedef std::list<BufferElement> Buffers;
    Buffers buffers_;
@@ -186,6 +207,11 @@ class CodeBuffer {
    Labels labels_;
    int curLabelID_;
 
+   // Absolute labels, by address, so that repeated passes hand out the
+   // same ids rather than growing labels_
+   typedef dyn_hash_map<Address, unsigned> AbsLabels;
+   AbsLabels absLabels_;
+
    int shift_;
 
    bool generated_;
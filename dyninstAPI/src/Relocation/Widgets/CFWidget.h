@@ -212,6 +212,7 @@ struct CFPatch : public Patch {
   
   virtual bool apply(codeGen &gen, CodeBuffer *buf);
   virtual unsigned estimate(codeGen &templ);
+  virtual bool relative() const;
   virtual ~CFPatch();
 
   Type type;
@@ -222,6 +223,8 @@ struct CFPatch : public Patch {
   arch_insn *ugly_insn;
   unsigned char* insn_ptr;
   bool hasCallFT_;
+  // Set by apply() if the last application went through the PLT
+  bool plt_;
 
 
 #if defined(arch_power)
@@ -86,6 +86,11 @@ class Widget {
 struct Patch {
    virtual bool apply(codeGen &gen, CodeBuffer *buf) = 0;
    virtual unsigned estimate(codeGen &templ) = 0;
+   // True if what apply() generates depends only on the distance from
+   // the current address to the labels it looks up, and apply() is safe
+   // to run concurrently with other relative patches. Such patches are
+   // only regenerated when one of those distances changes.
+   virtual bool relative() const { return false; }
    virtual ~Patch() {};
 };
 
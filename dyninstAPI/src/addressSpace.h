@@ -360,6 +360,12 @@ class AddressSpace : public InstructionSource {
     // Trampoline guard get/set functions
     int_variable* trampGuardBase(void) { return trampGuardBase_; }
     AstNodePtr trampGuardAST(void);
+    // Thread-pointer offset of the RT's tramp guard, or 0 if guards
+    // have to be taken by calling into the RT
+    long trampGuardTLSOffset();
+    // Thread-pointer offset of the RT's per-thread counter slab pointer,
+    // or 0 if counter snippets have to call DYNINSTcounterSlab()
+    long counterTLSOffset();
 
     // Get the current code generator (or emitter)
     Emitter *getEmitter();
@@ -524,6 +530,12 @@ class AddressSpace : public InstructionSource {
 
     int_variable* trampGuardBase_; // Tramp recursion index mapping
     AstNodePtr trampGuardAST_;
+    long trampGuardTLSOffset_;
+    bool trampGuardTLSResolved_;
+    long counterTLSOffset_;
+    bool counterTLSResolved_;
+
+    long resolveTLSOffset(const char *var, long &offset, bool &resolved);
 
     void *up_ptr_;
 
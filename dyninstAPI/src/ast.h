@@ -259,6 +259,24 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
    static AstNodePtr snippetNode(Dyninst::PatchAPI::SnippetPtr snip);
    static AstNodePtr goRuntimeUnwindNode(AddressSpace *addrSpace, int i);
 
+   // Test or set the RT's thread-local tramp guard directly; tls_offset
+   // is the guard's offset from the thread pointer
+   static AstNodePtr trampGuardLoadNode(long tls_offset);
+   static AstNodePtr trampGuardStoreNode(long tls_offset, int value);
+
+   // Load a pointer-width static TLS variable of the RT
+   static AstNodePtr tlsPointerNode(long tls_offset);
+   // Add amount to the calling thread's copy of an RT counter
+   static AstNodePtr counterIncrementNode(AddressSpace *addrSpace,
+                                          unsigned counter, long amount);
+
+   // Return an equivalent tree for the point gen is generating:
+   // constant operators are folded, identical keepable subtrees are
+   // merged so that they are computed once, and stores to a variable
+   // that are overwritten before any read are dropped.  Trees are
+   // shared between points, so ast itself is never modified.
+   static AstNodePtr optimize(AstNodePtr ast, codeGen &gen);
+
    AstNode(AstNodePtr src);
    //virtual AstNode &operator=(const AstNode &src);
 
@@ -530,6 +548,7 @@ class AstLabelNode : public AstNode {
 };
 
 class AstOperatorNode : public AstNode {
+    friend class AstOptimizer;
  public:
 
     AstOperatorNode(opCode opC, AstNodePtr l, AstNodePtr r = AstNodePtr(), AstNodePtr e = AstNodePtr());
@@ -581,6 +600,7 @@ class AstOperatorNode : public AstNode {
 
 class AstOperandNode : public AstNode {
     friend class AstOperatorNode; // ARGH
+    friend class AstOptimizer;
  public:
 
     // Direct operand
@@ -711,6 +731,7 @@ class AstCallNode : public AstNode {
 
 
 class AstSequenceNode : public AstNode {
+    friend class AstOptimizer;
  public:
     AstSequenceNode(std::vector<AstNodePtr> &sequence);
 
@@ -745,6 +766,7 @@ class AstSequenceNode : public AstNode {
 };
 
 class AstVariableNode : public AstNode {
+    friend class AstOptimizer;
   public:
     AstVariableNode(std::vector<AstNodePtr>&ast_wrappers, std::vector<std::pair<Offset, Offset> >*ranges);
 
@@ -972,6 +994,41 @@ class AstGoRuntimeUnwindNode : public AstNode {
     int paramIndex_;
 };
 
+class AstTrampGuardNode : public AstNode {
+    public:
+    AstTrampGuardNode(long offset, bool store, int value) :
+        offset_(offset), store_(store), value_(value) {};
+    bool canBeKept() const { return false; }
+    bool containsFuncCall() const { return false; }
+    bool usesAppRegister() const { return false; }
+
+    private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    long offset_;
+    bool store_;
+    int value_;
+};
+
+class AstTLSPointerNode : public AstNode {
+    public:
+    AstTLSPointerNode(long offset) : offset_(offset) {};
+    // A thread's TLS is invariant for the life of a snippet, except
+    // where the snippet itself stores to it
+    bool canBeKept() const { return true; }
+    bool containsFuncCall() const { return false; }
+    bool usesAppRegister() const { return false; }
+
+    private:
+    virtual bool generateCode_phase2(codeGen &gen,
+                                     bool noCost,
+                                     Address &retAddr,
+                                     Register &retReg);
+    long offset_;
+};
+
 void emitLoadPreviousStackFrameRegister(Address register_num,
 					Register dest,
                                         codeGen &gen,
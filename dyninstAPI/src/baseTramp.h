@@ -83,6 +83,8 @@ class baseTramp {
     AstNodePtr ast_;
     
     bool shouldRegenBaseTramp(registerSpace *rs); 
+    bool clobbersUnsavedRegs(registerSpace *rs);
+    registerSpace *startRegSpace(codeGen &gen);
 
  private:
     // We keep two sets of flags. The first controls which features
@@ -96,10 +98,15 @@ class baseTramp {
     bool needsStackFrame_;
     bool threaded_;
     bool optimizationInfo_;
+    bool minimalSaves_;
+    unsigned savedRegs_;
 
   public:    
     // Tracking the results of code generation.
     bool savedFPRs;
+    // FPRs the x86 emitters saved in bulk (fxsave or the XMM block);
+    // these have no spill slot in the registerSpace to count.
+    unsigned numSavedFPRs;
     bool createdFrame;
     bool savedOrigAddr;
     bool createdLocalSpace;
@@ -115,6 +122,10 @@ class baseTramp {
     
     
     bool validOptimizationInfo() { return optimizationInfo_; }
+    // Set by BPatch::setMinimalTrampSaves for tramps at instPoints
+    bool minimalSaves() const { return minimalSaves_; }
+    // Registers saved by the last generated tramp
+    unsigned numSavedRegs() const { return savedRegs_; }
 
  public:
     // Code generation methods
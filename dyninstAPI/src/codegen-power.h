@@ -163,6 +163,11 @@ class insnCodeGen {
                          bool isCall);
   static void saveVectors(codeGen & gen, int startStackOffset);
   static void restoreVectors(codeGen & gen, int startStackOffset);
+  // One vector register, in the slot saveVectors would use
+  static void saveVector(codeGen & gen, unsigned vectorReg, int startStackOffset,
+                         Register scratch);
+  static void restoreVector(codeGen & gen, unsigned vectorReg, int startStackOffset,
+                            Register scratch);
 
 };
 
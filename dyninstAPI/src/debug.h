@@ -111,6 +111,19 @@ extern const std::string CODEGEN_AST_TIMER;
 extern const std::string CODEGEN_AST_COUNTER;
 extern const std::string CODEGEN_REGISTER_TIMER;
 extern const std::string CODEGEN_LIVENESS_TIMER;
+extern const std::string CODEGEN_RELOC_TIMER;
+extern const std::string CODEGEN_RELOC_PASS_COUNTER;
+extern const std::string CODEGEN_RELOC_EMIT_COUNTER;
+extern const std::string CODEGEN_RELOC_REUSE_COUNTER;
+extern const std::string CODEGEN_TRAMP_COUNTER;
+extern const std::string CODEGEN_TRAMP_BYTES_COUNTER;
+extern const std::string CODEGEN_TRAMP_COST_COUNTER;
+extern const std::string CODEGEN_TRAMP_UNOPT_COST_COUNTER;
+extern const std::string CODEGEN_TRAMP_SAVED_REGS_COUNTER;
+extern const std::string CODEGEN_TRAMP_SAVE_FALLBACK_COUNTER;
+extern const std::string CODEGEN_AST_OPT_FOLD_COUNTER;
+extern const std::string CODEGEN_AST_OPT_SHARE_COUNTER;
+extern const std::string CODEGEN_AST_OPT_STORE_COUNTER;
 
 // C++ prototypes
 #define signal_cerr       if (dyn_debug_signal) cerr
@@ -179,6 +179,11 @@ public:
     Address getTOCoffsetInfo(func_instance *func); // platform-specific
     bool getOPDFunctionAddr(Address &opdAddr); // architecture-specific
 
+    // Map a thread's counter slab ahead of its first increment, so that
+    // counter snippets that read the slab from TLS never call the RT
+    bool mapCounterSlab(PCThread *thread, bool synchronous);
+    bool mapCounterSlabs();
+
     // iRPC interface
     bool postIRPC(AstNodePtr action,
                  void *userData,
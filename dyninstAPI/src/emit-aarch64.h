@@ -174,6 +174,12 @@ public:
     virtual bool emitPadding(int, codeGen&);
     virtual bool emitGoUnwindTranslate(int, codeGen&) { assert(0); return true; }
 
+    virtual bool inlineTrampGuard() const { return true; }
+    virtual bool emitLoadTrampGuard(Register dest, long tls_offset, codeGen &gen);
+    virtual bool emitStoreTrampGuard(long tls_offset, int value, codeGen &gen);
+    virtual bool inlineTLSLoad() const { return true; }
+    virtual bool emitLoadTLSPointer(Register dest, long tls_offset, codeGen &gen);
+
 protected:
     virtual bool emitCallInstruction(codeGen &, func_instance *,
                                      bool, Address);
@@ -229,7 +235,9 @@ public:
     unsigned saveGPRegisters(codeGen &gen, registerSpace *theRegSpace,
             int offset, int numReqGPRs = -1);
 
-    unsigned saveFPRegisters(codeGen &gen, registerSpace *theRegSpace, int offset);
+    // onlyLive: skip vector registers that are dead at the point
+    unsigned saveFPRegisters(codeGen &gen, registerSpace *theRegSpace, int offset,
+            bool onlyLive = false);
 
     unsigned saveSPRegisters(codeGen &gen, registerSpace *, int offset, bool force_save);
 
@@ -247,7 +255,8 @@ public:
 
     unsigned restoreGPRegisters(codeGen &gen, registerSpace *theRegSpace, int offset);
 
-    unsigned restoreFPRegisters(codeGen &gen, registerSpace *theRegSpace, int offset);
+    unsigned restoreFPRegisters(codeGen &gen, registerSpace *theRegSpace, int offset,
+            bool onlyLive = false);
 
     unsigned restoreSPRegisters(codeGen &gen, registerSpace *, int offset, int force_save);
 
@@ -269,6 +269,14 @@ public:
     bool emitXorRegSegReg(Register dest, Register base, int disp, codeGen& gen);
     bool emitGoUnwindTranslate(int, codeGen&);
 
+    // The guard is addressed off %fs, which only the dynamic emitter's
+    // address space can resolve (see AddressSpace::trampGuardTLSOffset)
+    bool inlineTrampGuard() const { return true; }
+    bool emitLoadTrampGuard(Register dest, long tls_offset, codeGen &gen);
+    bool emitStoreTrampGuard(long tls_offset, int value, codeGen &gen);
+    bool inlineTLSLoad() const { return true; }
+    bool emitLoadTLSPointer(Register dest, long tls_offset, codeGen &gen);
+
  protected:
     virtual bool emitCallInstruction(codeGen &gen, func_instance *target, Register ret) = 0;
 
@@ -119,6 +119,15 @@ class Emitter {
     virtual bool emitTOCJump(block_instance *, codeGen &) { assert(0); return false; }
     virtual bool emitTOCCall(block_instance *, codeGen &) { assert(0); return false; }
 
+    // Inline access to the RT's TLS tramp guard
+    virtual bool inlineTrampGuard() const { return false; }
+    virtual bool emitLoadTrampGuard(Register, long, codeGen &) { assert(0); return false; }
+    virtual bool emitStoreTrampGuard(long, int, codeGen &) { assert(0); return false; }
+    // Load the pointer-width static TLS variable at the given offset from
+    // the thread pointer; only called if inlineTLSLoad()
+    virtual bool inlineTLSLoad() const { return false; }
+    virtual bool emitLoadTLSPointer(Register, long, codeGen &) { assert(0); return false; }
+
     virtual bool emitPadding(int p, codeGen&) = 0;
     virtual bool emitGoUnwindTranslate(int, codeGen&) = 0;
 };
@@ -228,12 +228,13 @@ unsigned saveGPRegisters(codeGen &gen,
 unsigned restoreGPRegisters(codeGen &gen, 
                             registerSpace *theRegSpace,
                             int save_off);
+// onlyLive: save/restore just the vector registers live at the point
 unsigned saveFPRegisters(codeGen &gen, 
                          registerSpace *theRegSpace,
-                         int save_off);
+                         int save_off, bool onlyLive = false);
 unsigned restoreFPRegisters(codeGen &gen,
                             registerSpace *theRegSpace,
-                            int save_off);
+                            int save_off, bool onlyLive = false);
 unsigned saveSPRegisters(codeGen &gen, registerSpace *,
                          int save_off, int force_save);
 unsigned restoreSPRegisters(codeGen &gen, registerSpace *,
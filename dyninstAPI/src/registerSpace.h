@@ -329,6 +329,9 @@ class registerSpace {
     bool anyLiveFPRsAtEntry() const;
     bool anyLiveSPRsAtEntry() const;
 
+    // How many tramp registers, FPRs and SPRs are currently saved
+    unsigned numSavedRegisters();
+
 
     /**
      * The following set of 'public' and 'private' methods and data deal with
@@ -54,10 +54,16 @@ class trampTrapMappings {
    dyn_hash_map<Address, tramp_mapping_t> mapping;
    std::set<tramp_mapping_t *> updated_mappings;
 
-   static void arrange_mapping(tramp_mapping_t &m, bool should_sort,
+   static void arrange_mapping(tramp_mapping_t &m, bool rebuild,
                                std::vector<tramp_mapping_t*> &mappings_to_add,
                                std::vector<tramp_mapping_t*> &mappings_to_update);
 
+   //Mutator-side copy of the source column of the mutatee's hashed table
+   // (0 == empty slot), used to place new entries without reading it back.
+   std::vector<Address> table_slots;
+   Address hashBase() const;
+   unsigned findSlot(Address from, Address base);
+
    bool needs_updating;
    AddressSpace *as;
 
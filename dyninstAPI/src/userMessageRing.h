@@ -0,0 +1,92 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(USER_MESSAGE_RING_H)
+#define USER_MESSAGE_RING_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <boost/atomic.hpp>
+
+#include "common/src/dthread.h"
+#include "common/src/Types.h"
+#include "dyninstAPI_RT/h/dyninstAPI_RT.h"
+
+class BPatch_process;
+
+// Asynchronous transport for DYNINSTuserMessage and dynamic call-site
+// reports.  We create a shared segment of per-thread SPSC rings (see
+// DYNINST_msg_ring_header_t), hand its path to the runtime library, and
+// drain it from a poller thread.  User-message callbacks run on the
+// poller thread.  Call-site reports need Dyninst's CFG, so the poller
+// only queues them; deliverCallsites() runs them from the thread that
+// handles process events.
+//
+// Messages that do not fit still come through the breakpoint path;
+// PCEventHandler drains the rings first so per-thread order is kept.
+class UserMessageRing {
+  public:
+    // NULL if the platform or the runtime library does not support it
+    static UserMessageRing *create(BPatch_process *proc);
+    ~UserMessageRing();
+
+    // Returns the number of records consumed
+    unsigned drain();
+    void deliverCallsites();
+
+    // Messages that took the breakpoint path because a ring was full
+    unsigned long overflows() const;
+
+  private:
+    UserMessageRing(BPatch_process *proc);
+    bool init();
+    void stop();
+    unsigned drainRing(DYNINST_msg_ring_t *ring);
+    void dropCorruptRing(DYNINST_msg_ring_t *ring, uint32_t tail);
+    static DThread::dthread_ret_t WINAPI main(void *);
+
+    BPatch_process *proc_;
+    std::string path_;
+    DYNINST_msg_ring_header_t *hdr_;
+
+    DThread thrd_;
+    boost::atomic<bool> done_;
+
+    // Serializes drains between the poller and the event handler
+    Mutex<> drainLock_;
+    std::vector<unsigned char> scratch_;
+
+    Mutex<> callsiteLock_;
+    std::vector<std::pair<Dyninst::Address, Dyninst::Address> > callsites_;
+};
+
+#endif
@@ -145,6 +145,77 @@ typedef struct {
    int index;        /*Index of the dead thread*/
 } BPatch_deleteThreadEventRecord;
 
+/* Asynchronous user messages.  When enabled, the mutator creates a
+ * shared segment of single-producer/single-consumer rings and writes
+ * its path into DYNINST_msg_ring_name.  Each mutatee thread claims a
+ * ring on its first message and appends DYNINST_msg_record_t headers
+ * followed by the payload, padded to 8 bytes; the mutator drains the
+ * rings from a poller thread.  A message that does not fit falls back
+ * to the DSE_userMessage/DSE_dynFuncCall breakpoint.  Positions are
+ * free-running byte counts; DYNINST_MSG_RING_BYTES is a power of two. */
+#define DYNINST_MSG_RING_MAGIC 0x44524E47
+#define DYNINST_MSG_RING_COUNT 64
+#define DYNINST_MSG_RING_BYTES (128*1024)
+#define DYNINST_MSG_RING_NAME_LEN 64
+
+/* Ring owners.  Threads claim the first ring not OWNED and release it
+ * when they exit, so never-claimed (FREE) rings are always at the end. */
+#define DYNINST_MSG_RING_FREE 0
+#define DYNINST_MSG_RING_OWNED 1
+#define DYNINST_MSG_RING_RELEASED 2
+
+typedef struct {
+   volatile uint32_t tail;      /* producer position, owning thread only */
+   volatile uint32_t owner;     /* DYNINST_MSG_RING_{FREE,OWNED,RELEASED} */
+   volatile uint32_t overflows; /* messages sent through the breakpoint */
+   uint32_t pad0[13];
+   volatile uint32_t head;      /* consumer position, mutator only */
+   uint32_t pad1[15];
+   unsigned char data[DYNINST_MSG_RING_BYTES];
+} DYNINST_msg_ring_t;
+
+typedef struct {
+   uint32_t magic;
+   uint32_t num_rings;
+   uint32_t ring_bytes;
+   uint32_t pad[13];
+   DYNINST_msg_ring_t rings[DYNINST_MSG_RING_COUNT];
+} DYNINST_msg_ring_header_t;
+
+typedef struct {
+   uint32_t type;    /* DSE_userMessage or DSE_dynFuncCall */
+   uint32_t size;    /* payload bytes, before padding */
+} DYNINST_msg_record_t;
+
+/* DSE_dynFuncCall payload; 64-bit so that both ABIs agree */
+typedef struct {
+   uint64_t call_target;
+   uint64_t call_site_addr;
+} DYNINST_msg_dynCallRecord_t;
+
+/* Per-thread counters for BPatch_counterIncrementExpr.  Each thread
+ * that increments a counter gets its own slab: a DYNINST_counter_slab_t
+ * header followed by DYNINST_COUNTER_MAX pointer-width counters, so no
+ * two threads share a cache line and the increments need no atomics.
+ * DYNINSTcounterSlab() returns the calling thread's counters, mapping a
+ * slab on first use and caching it in TLS; DYNINST_counter_tls_offset
+ * is the offset of that cache from the thread pointer, or 0.  When it
+ * is set, the mutator calls DYNINSTcounterSlab() in each thread before
+ * the thread runs, and snippets only load the cache and skip the
+ * increment while it is NULL.  Slabs are pushed on the
+ * DYNINST_counter_slabs list and never freed, so the counts of exited
+ * threads stay in the totals.  A thread whose slab cannot be mapped
+ * gets NULL, and DYNINST_counter_dropped counts the increments that
+ * call DYNINSTcounterSlab() and find none. */
+#define DYNINST_COUNTER_MAX (1024*1024)
+#define DYNINST_COUNTER_SLAB_MAGIC 0x44434E54
+
+typedef struct {
+   uint64_t next;    /* address of the next slab header, 0 at the end */
+   uint32_t magic;
+   uint32_t pad[13];
+} DYNINST_counter_slab_t;
+
 /* Let's define some constants for, well, everything.... */
 /* These should be different to avoid unexpected collisions */
 
@@ -163,6 +234,19 @@ typedef struct {
    void *target;
 } trapMapping_t;
 
+/* Layouts of a trap table, as stored in dyninstTrapTableIsSorted and in
+ * trap_mapping_header.layout.  A hashed table is open-addressed with
+ * linear probing; its size is a power of two, empty slots have a NULL
+ * source, and the slot for an address is
+ *    DYNINST_TRAP_HASH(source - base) & (size - 1)
+ * where base is 0 for the dynamic table and the (unrelocated) header
+ * address for a rewritten binary, so the layout survives relocation. */
+#define DYNINST_TRAP_TABLE_UNSORTED 0
+#define DYNINST_TRAP_TABLE_SORTED 1
+#define DYNINST_TRAP_TABLE_HASHED 2
+#define DYNINST_TRAP_HASH(key) \
+   ((uint32_t) (((uint64_t) (key) * 0x9E3779B97F4A7C15ULL) >> 32))
+
 #define TRAP_HEADER_SIG 0x759191D6
 #define DT_DYNINST 0x6D191957
 #define DT_DYNINST_RAMAP 0x6D191958
@@ -175,7 +259,7 @@ struct trap_mapping_header {
    uint32_t signature;
    uint32_t num_entries;
    int32_t pos;
-  uint32_t padding;
+   uint32_t layout; /* 0 (sorted) or DYNINST_TRAP_TABLE_HASHED */
    uint64_t low_entry;
    uint64_t high_entry;
    trapMapping_t traps[]; //Don't change this to a pointer, despite any compiler warnings
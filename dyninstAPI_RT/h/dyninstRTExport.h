@@ -54,6 +54,11 @@
     being sent to the mutator, and then passed to the callback function
     provided by the API user via registerUserMessageCallback().
 
+    If the mutator enabled BPatch::setAsyncUserMessages(), the message
+    is copied into a shared ring and the caller does not stop; the
+    callback then runs later on a mutator thread.  Messages larger than
+    the ring, or sent while it is full, still stop the process.
+
     Returns zero on success, nonzero on failure.
   */
 DLLEXPORT int DYNINSTuserMessage(void *msg, unsigned int msg_size);
@@ -62,6 +67,14 @@ DLLEXPORT int DYNINSTuserMessage(void *msg, unsigned int msg_size);
    may differ at certain times from the number of threads actually present.) */
 DLLEXPORT int DYNINSTthreadCount();
 
+/* Sums per-thread counters [first, first + count), as allocated with
+   BPatch_addressSpace::allocateCounters(), over every thread into
+   totals[0 .. count).  Lets a user's runtime library report the same
+   totals as BPatch_process::readCounters().  Returns the number of
+   thread slabs summed, or -1 if the range is out of bounds. */
+DLLEXPORT int DYNINSTcounterTotals(unsigned int first, unsigned int count,
+                                   unsigned long long *totals);
+
 /**
  * These function implement a locking mechanism that can be used by 
  * a user's runtime library.
@@ -107,6 +120,7 @@ DLLEXPORT unsigned long RTtranslateMemory(unsigned long, unsigned long, unsigned
 DLLEXPORT unsigned long RTtranslateMemoryShift(unsigned long, unsigned long, unsigned long);
 DLLEXPORT void *DYNINSTos_malloc(size_t, void *, void *); 
 DLLEXPORT int DYNINSTloadLibrary(char *);
+DLLEXPORT void *DYNINSTcounterSlab();
 
 /** 
  * And variables
@@ -114,22 +114,6 @@ FILE *stOut;
 int fakeTickCount;
 
 
-#ifdef _MSC_VER
-#define TLS_VAR __declspec(thread)
-#else
-// Note, the initial-exec model gives us static TLS which can be accessed
-// directly, unlike dynamic TLS that calls __tls_get_addr().  Such calls risk
-// recursing back to us if they're also instrumented, ad infinitum.  Static TLS
-// must be used very sparingly though, because it is a limited resource.
-// *** This case is very special -- do not use IE in general libraries! ***
-
-#if defined(DYNINST_RT_STATIC_LIB)
-#define TLS_VAR __thread __attribute__ ((tls_model("local-exec")))
-#else
-#define TLS_VAR __thread __attribute__ ((tls_model("initial-exec")))
-#endif
-#endif
-
 // It's tempting to make this a char, but glibc < 2.17 hits a bug:
 //   https://sourceware.org/bugzilla/show_bug.cgi?id=14898
 static TLS_VAR short DYNINST_tls_tramp_guard = 1;
@@ -145,6 +129,35 @@ DLLEXPORT void DYNINST_unlock_tramp_guard()
   DYNINST_tls_tramp_guard = 1;
 }
 
+// Offset of DYNINST_tls_tramp_guard from the thread pointer.  The guard is
+// in static TLS, so the offset is the same in every thread; the mutator
+// reads it once and then tests and sets the guard inline rather than
+// calling the functions above.  0 means it is not available here.
+DLLEXPORT long DYNINST_tramp_guard_tls_offset = 0;
+
+// Offset of a static TLS variable from the thread pointer, or 0 where
+// the mutator cannot load the thread pointer inline.
+long DYNINSTtlsOffset(void *var)
+{
+#if !defined(_MSC_VER) && defined(arch_x86_64) && !defined(MUTATEE_32)
+  char *tp;
+  __asm__ ("mov %%fs:0, %0" : "=r" (tp));
+  return (char *) var - tp;
+#elif !defined(_MSC_VER) && defined(arch_aarch64)
+  char *tp;
+  __asm__ ("mrs %0, tpidr_el0" : "=r" (tp));
+  return (char *) var - tp;
+#else
+  (void) var;
+  return 0;
+#endif
+}
+
+static void initTrampGuardOffset()
+{
+  DYNINST_tramp_guard_tls_offset = DYNINSTtlsOffset((void *) &DYNINST_tls_tramp_guard);
+}
+
 DECLARE_DYNINST_LOCK(DYNINST_trace_lock);
 
 /**
@@ -170,6 +183,8 @@ void DYNINSTBaseInit()
    DYNINSTinitializeTrapHandler();
 #endif
    DYNINST_unlock_tramp_guard();
+   initTrampGuardOffset();
+   DYNINSTcounterInit();
    DYNINSThasInitialized = 1;
 
    RTuntranslatedEntryCounter = 0;
@@ -566,6 +581,11 @@ DLLEXPORT RT_Boolean DYNINST_boundsCheck(void **boundsArray_, void *arrayLen_,
 DLLEXPORT int DYNINSTasyncDynFuncCall (void * call_target, void *call_addr) {
     if (DYNINSTstaticMode) return 0;
 
+#if defined(os_linux)
+    /* Without a stop if the mutator set up a message ring */
+    if (DYNINSTmsgRingDynFuncCall(call_target, call_addr)) return 0;
+#endif
+
     tc_lock_lock(&DYNINST_trace_lock);
 
     /* Set the state so the mutator knows what's up */
@@ -591,6 +611,10 @@ int DYNINSTuserMessage(void *msg, unsigned int msg_size) {
 		return 0;
 	}
 
+#if defined(os_linux)
+    if (DYNINSTmsgRingUserMessage(msg, msg_size)) return 0;
+#endif
+
     tc_lock_lock(&DYNINST_trace_lock);
 
 
@@ -702,7 +726,8 @@ void* dyninstTrapTranslate(void *source,
                            volatile unsigned long *table_used,
                            volatile unsigned long *table_version,
                            volatile trapMapping_t **trap_table,
-                           volatile unsigned long *is_sorted)
+                           volatile unsigned long *is_sorted,
+                           unsigned long hash_base)
 {
    volatile unsigned local_version;
    unsigned i;
@@ -712,7 +737,25 @@ void* dyninstTrapTranslate(void *source,
       local_version = *table_version;
       target = NULL;
 
-      if (*is_sorted)
+      if (*is_sorted == DYNINST_TRAP_TABLE_HASHED)
+      {
+         /* The mutator keeps the table at most half full, so this is
+          * almost always one or two probes.  table_used is the number
+          * of slots here, not the number of entries. */
+         unsigned long mask = *table_used - 1;
+         unsigned long slot = DYNINST_TRAP_HASH((unsigned long) source - hash_base) & mask;
+         for (i = 0; i <= mask; i++) {
+            volatile trapMapping_t *t = &(*trap_table)[slot];
+            if (t->source == source) {
+               target = t->target;
+               break;
+            }
+            if (!t->source)
+               break;
+            slot = (slot + 1) & mask;
+         }
+      }
+      else if (*is_sorted)
       {
          unsigned min = 0;
          unsigned mid = 0;
@@ -36,6 +36,22 @@
 #include <stdarg.h>
 #include <signal.h>
 
+#ifdef _MSC_VER
+#define TLS_VAR __declspec(thread)
+#else
+// Note, the initial-exec model gives us static TLS which can be accessed
+// directly, unlike dynamic TLS that calls __tls_get_addr().  Such calls risk
+// recursing back to us if they're also instrumented, ad infinitum.  Static TLS
+// must be used very sparingly though, because it is a limited resource.
+// *** This case is very special -- do not use IE in general libraries! ***
+
+#if defined(DYNINST_RT_STATIC_LIB)
+#define TLS_VAR __thread __attribute__ ((tls_model("local-exec")))
+#else
+#define TLS_VAR __thread __attribute__ ((tls_model("initial-exec")))
+#endif
+#endif
+
 void DYNINSTtrapFunction();
 void DYNINSTbreakPoint();
 /* Use a signal that is safe if we're not attached. */
@@ -44,13 +60,24 @@ void DYNINSTinit();
 int DYNINSTreturnZero();
 int DYNINSTwriteEvent(void *ev, size_t sz);
 int DYNINSTasyncConnect(int pid);
+long DYNINSTtlsOffset(void *var);
+void DYNINSTcounterInit();
+
+#if defined(os_linux)
+/* Shared-memory message rings (RTmsgring.c).  The put functions return
+   nonzero if the message was queued, zero if the caller must fall back
+   to the breakpoint path. */
+int DYNINSTmsgRingUserMessage(void *msg, unsigned int msg_size);
+int DYNINSTmsgRingDynFuncCall(void *call_target, void *call_addr);
+#endif
 
 int DYNINSTinitializeTrapHandler();
 void* dyninstTrapTranslate(void *source, 
                            volatile unsigned long *table_used,
                            volatile unsigned long *table_version,
                            volatile trapMapping_t **trap_table,
-                           volatile unsigned long *is_sorted);
+                           volatile unsigned long *is_sorted,
+                           unsigned long hash_base);
 
 extern int DYNINST_mutatorPid;
 extern int libdyninstAPI_RT_init_localCause;
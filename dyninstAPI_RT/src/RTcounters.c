@@ -0,0 +1,147 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/************************************************************************
+ * RTcounters.c: per-thread counter slabs for BPatch_counterIncrementExpr.
+ * See dyninstAPI_RT.h for the layout.
+ ************************************************************************/
+
+#include <string.h>
+#if defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "dyninstAPI_RT/h/dyninstAPI_RT.h"
+#include "dyninstAPI_RT/src/RTcommon.h"
+
+#define COUNTER_SLAB_BYTES \
+   (sizeof(DYNINST_counter_slab_t) + DYNINST_COUNTER_MAX * sizeof(uintptr_t))
+
+/* Head of the slab list, read by the mutator */
+DLLEXPORT DYNINST_counter_slab_t * volatile DYNINST_counter_slabs = NULL;
+
+/* Offset of counter_slab from the thread pointer; see
+   AddressSpace::counterTLSOffset.  0 means snippets must call
+   DYNINSTcounterSlab() every time. */
+DLLEXPORT long DYNINST_counter_tls_offset = 0;
+
+/* Increments dropped because the thread's slab could not be mapped */
+DLLEXPORT volatile long DYNINST_counter_dropped = 0;
+
+static TLS_VAR uintptr_t *counter_slab = NULL;
+
+static void counter_push(DYNINST_counter_slab_t *slab)
+{
+   DYNINST_counter_slab_t *head;
+   slab->magic = DYNINST_COUNTER_SLAB_MAGIC;
+   do {
+      head = DYNINST_counter_slabs;
+      slab->next = (uint64_t) (uintptr_t) head;
+#if defined(_MSC_VER)
+   } while (InterlockedCompareExchangePointer((PVOID volatile *) &DYNINST_counter_slabs,
+                                              slab, head) != head);
+#else
+   } while (!__sync_bool_compare_and_swap(&DYNINST_counter_slabs, head, slab));
+#endif
+}
+
+static DYNINST_counter_slab_t *counter_map_slab()
+{
+   void *mem;
+#if defined(_MSC_VER)
+   mem = VirtualAlloc(NULL, COUNTER_SLAB_BYTES, MEM_COMMIT | MEM_RESERVE,
+                      PAGE_READWRITE);
+#else
+   int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_NORESERVE)
+   flags |= MAP_NORESERVE;
+#endif
+   mem = mmap(NULL, COUNTER_SLAB_BYTES, PROT_READ | PROT_WRITE, flags, -1, 0);
+   if (mem == MAP_FAILED)
+      mem = NULL;
+#endif
+   return (DYNINST_counter_slab_t *) mem;
+}
+
+/* Called through an iRPC by the mutator, which maps each thread's slab
+   before the thread runs a counter snippet that reads it from TLS, and
+   by snippets on every increment where TLS cannot be read inline.
+   Returns NULL, and counts the increment as dropped, if no slab can be
+   mapped; the next increment tries again. */
+DLLEXPORT void *DYNINSTcounterSlab()
+{
+   DYNINST_counter_slab_t *slab;
+
+   if (counter_slab)
+      return counter_slab;
+
+   slab = counter_map_slab();
+   if (!slab) {
+      rtdebug_printf("%s[%d]: failed to map a counter slab, dropping increment\n",
+                     __FILE__, __LINE__);
+#if defined(_MSC_VER)
+      InterlockedIncrement(&DYNINST_counter_dropped);
+#else
+      __sync_fetch_and_add(&DYNINST_counter_dropped, 1);
+#endif
+      return NULL;
+   }
+   counter_push(slab);
+   counter_slab = (uintptr_t *) (slab + 1);
+   return counter_slab;
+}
+
+DLLEXPORT int DYNINSTcounterTotals(unsigned int first, unsigned int count,
+                                   unsigned long long *totals)
+{
+   DYNINST_counter_slab_t *slab;
+   unsigned int i;
+   int slabs = 0;
+
+   if (first > DYNINST_COUNTER_MAX || count > DYNINST_COUNTER_MAX - first)
+      return -1;
+
+   memset(totals, 0, count * sizeof(*totals));
+   for (slab = DYNINST_counter_slabs; slab;
+        slab = (DYNINST_counter_slab_t *) (uintptr_t) slab->next) {
+      uintptr_t *counters = (uintptr_t *) (slab + 1);
+      for (i = 0; i < count; i++)
+         totals[i] += counters[first + i];
+      slabs++;
+   }
+   return slabs;
+}
+
+void DYNINSTcounterInit()
+{
+   DYNINST_counter_tls_offset = DYNINSTtlsOffset((void *) &counter_slab);
+}
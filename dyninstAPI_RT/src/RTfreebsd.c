@@ -311,24 +311,28 @@ void dyninstTrapHandler(int sig, siginfo_t *sg, ucontext_t *context)
    // Find the new IP we're going to and substitute. Leave everything else untouched
    if (DYNINSTstaticMode) {
       unsigned long zero = 0;
-      unsigned long one = 1;
+      unsigned long layout;
       struct trap_mapping_header *hdr = getStaticTrapMap((unsigned long) orig_ip);
       if (!hdr) return;
 
       assert(hdr);
       trapMapping_t *mapping = &(hdr->traps[0]);
+      layout = (hdr->layout == DYNINST_TRAP_TABLE_HASHED) ?
+         DYNINST_TRAP_TABLE_HASHED : DYNINST_TRAP_TABLE_SORTED;
       trap_to = dyninstTrapTranslate(orig_ip, 
                                      (unsigned long *) &hdr->num_entries, 
                                      &zero, 
                                      (volatile trapMapping_t **) &mapping,
-                                     &one);
+                                     &layout,
+                                     (unsigned long) hdr);
    }
    else {
       trap_to = dyninstTrapTranslate(orig_ip, 
                                      &dyninstTrapTableUsed,
                                      &dyninstTrapTableVersion,
                                      (volatile trapMapping_t **) &dyninstTrapTable,
-                                     &dyninstTrapTableIsSorted);
+                                     &dyninstTrapTableIsSorted,
+                                     0);
                                      
    }
    UC_PC(context) = (long) trap_to;
@@ -476,6 +480,8 @@ static int parse_link_map(struct link_map *l)
  
    for (i = 0; i < header->num_entries; i++)
    {
+      if (!header->traps[i].source)
+         continue; /* empty slot in a hashed table */
       header->traps[i].source = (void *) (((unsigned long) header->traps[i].source) + libAddr);
       header->traps[i].target = (void *) (((unsigned long) header->traps[i].target) + libAddr);
       if (!header->low_entry || header->low_entry > (unsigned long) header->traps[i].source)
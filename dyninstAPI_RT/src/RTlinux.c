@@ -393,17 +393,20 @@ void dyninstTrapHandler(int sig, siginfo_t *sg, ucontext_t *context)
    // Find the new IP we're going to and substitute. Leave everything else untouched.
    if (DYNINSTstaticMode) {
       unsigned long zero = 0;
-      unsigned long one = 1;
+      unsigned long layout;
       struct trap_mapping_header *hdr = getStaticTrapMap((unsigned long) orig_ip);
       if (hdr) {
       num_entries = hdr->num_entries;
       assert(hdr);
       volatile trapMapping_t *mapping = &(hdr->traps[0]);
+      layout = (hdr->layout == DYNINST_TRAP_TABLE_HASHED) ?
+         DYNINST_TRAP_TABLE_HASHED : DYNINST_TRAP_TABLE_SORTED;
       trap_to = dyninstTrapTranslate(orig_ip,
                                      (unsigned long *) &hdr->num_entries,
                                      &zero,
                                      &mapping,
-                                     &one);
+                                     &layout,
+                                     (unsigned long) hdr);
       }
    }
    else {
@@ -411,7 +414,8 @@ void dyninstTrapHandler(int sig, siginfo_t *sg, ucontext_t *context)
                                      &dyninstTrapTableUsed,
                                      &dyninstTrapTableVersion,
                                      &dyninstTrapTable,
-                                     &dyninstTrapTableIsSorted);
+                                     &dyninstTrapTableIsSorted,
+                                     0);
 
    }
    if (trap_to == NULL) {       
@@ -542,6 +546,8 @@ static int parse_link_map(struct link_map *l)
    rtdebug_printf("rewritten binary load address %lx\n", l->l_addr);
    for (i = 0; i < header->num_entries; i++)
    {
+      if (!header->traps[i].source)
+         continue; /* empty slot in a hashed table */
       header->traps[i].source = (void *) (((unsigned long) header->traps[i].source) + l->l_addr);
       header->traps[i].target = (void *) (((unsigned long) header->traps[i].target) + l->l_addr);
       rtdebug_printf("trampoline from %p to %p\n", header->traps[i].source, header->traps[i].target);
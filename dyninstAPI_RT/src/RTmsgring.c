@@ -0,0 +1,268 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/************************************************************************
+ * RTmsgring.c: shared-memory rings for DYNINSTuserMessage and dynamic
+ * call-site reports.  See dyninstAPI_RT.h for the layout.
+ ************************************************************************/
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "dyninstAPI_RT/h/dyninstAPI_RT.h"
+#include "dyninstAPI_RT/src/RTcommon.h"
+
+/* Path of the segment, written by the mutator; empty when disabled */
+DLLEXPORT char DYNINST_msg_ring_name[DYNINST_MSG_RING_NAME_LEN];
+
+#define MSG_RING_UNMAPPED 0
+#define MSG_RING_MAPPING 1
+#define MSG_RING_MAPPED 2
+#define MSG_RING_FAILED 3
+
+static DYNINST_msg_ring_header_t *msg_ring_hdr = NULL;
+static volatile int msg_ring_state = MSG_RING_UNMAPPED;
+
+/* The process that mapped msg_ring_hdr.  A forked child inherits the
+   mapping, but the segment belongs to the parent; the mutator writes the
+   child a name of its own. */
+static pid_t msg_ring_pid = 0;
+static char msg_ring_parent_name[DYNINST_MSG_RING_NAME_LEN];
+
+/* Bumped on every mapping, so slots claimed in an older one are dropped */
+static volatile unsigned msg_ring_gen = 0;
+
+/* 0: not claimed yet, -1: no ring left, otherwise ring index + 1 */
+static TLS_VAR int msg_ring_slot = 0;
+static TLS_VAR unsigned msg_ring_slot_gen = 0;
+
+/* Releases the calling thread's ring when it exits.  libpthread is looked
+   up rather than linked, as for DYNINST_pthread_self. */
+typedef int (*msg_ring_setspecific_t)(pthread_key_t, const void *);
+static msg_ring_setspecific_t msg_ring_setspecific = NULL;
+static pthread_key_t msg_ring_key;
+
+static void msg_ring_thread_exit(void *arg)
+{
+   (void) arg;
+   if (msg_ring_slot <= 0 || msg_ring_slot_gen != msg_ring_gen ||
+       __atomic_load_n(&msg_ring_state, __ATOMIC_ACQUIRE) != MSG_RING_MAPPED)
+      return;
+   /* Data still in the ring is drained as usual; the next owner appends
+      after it. */
+   __atomic_store_n(&msg_ring_hdr->rings[msg_ring_slot - 1].owner,
+                    DYNINST_MSG_RING_RELEASED, __ATOMIC_RELEASE);
+   msg_ring_slot = 0;
+}
+
+static void msg_ring_init_thread_exit()
+{
+   typedef int (*key_create_t)(pthread_key_t *, void (*)(void *));
+   key_create_t key_create;
+
+   if (msg_ring_setspecific)
+      return;
+   key_create = (key_create_t) dlsym(RTLD_DEFAULT, "pthread_key_create");
+   if (!key_create || key_create(&msg_ring_key, msg_ring_thread_exit) != 0)
+      return;
+   msg_ring_setspecific =
+      (msg_ring_setspecific_t) dlsym(RTLD_DEFAULT, "pthread_setspecific");
+}
+
+/* In a forked child: let go of the parent's segment.  Returns nonzero if
+   the caller may map the child's own. */
+static int msg_ring_forked()
+{
+   if (!__sync_bool_compare_and_swap(&msg_ring_state, MSG_RING_MAPPED,
+                                     MSG_RING_MAPPING))
+      return 0;
+   munmap(msg_ring_hdr, sizeof(DYNINST_msg_ring_header_t));
+   msg_ring_hdr = NULL;
+   __atomic_store_n(&msg_ring_state, MSG_RING_UNMAPPED, __ATOMIC_RELEASE);
+   return 1;
+}
+
+static DYNINST_msg_ring_header_t *msg_ring_map()
+{
+   DYNINST_msg_ring_header_t *hdr;
+   int fd;
+
+   int state = __atomic_load_n(&msg_ring_state, __ATOMIC_ACQUIRE);
+
+   if (state == MSG_RING_MAPPED) {
+      if (msg_ring_pid == getpid())
+         return msg_ring_hdr;
+      if (!msg_ring_forked())
+         return NULL;
+      state = MSG_RING_UNMAPPED;
+   }
+   if (state != MSG_RING_UNMAPPED || !DYNINST_msg_ring_name[0])
+      return NULL;
+   /* A child the mutator hasn't set up yet still has the parent's name */
+   if (msg_ring_parent_name[0] &&
+       !strncmp(DYNINST_msg_ring_name, msg_ring_parent_name,
+                DYNINST_MSG_RING_NAME_LEN))
+      return NULL;
+   /* Whoever loses the race falls back until the winner is done */
+   if (!__sync_bool_compare_and_swap(&msg_ring_state, MSG_RING_UNMAPPED,
+                                     MSG_RING_MAPPING))
+      return NULL;
+
+   fd = open(DYNINST_msg_ring_name, O_RDWR);
+   if (fd == -1) {
+      rtdebug_printf("%s[%d]: failed to open message ring %s\n",
+                     __FILE__, __LINE__, DYNINST_msg_ring_name);
+      msg_ring_state = MSG_RING_FAILED;
+      return NULL;
+   }
+   hdr = (DYNINST_msg_ring_header_t *) mmap(NULL,
+            sizeof(DYNINST_msg_ring_header_t), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+   close(fd);
+   if (hdr == (DYNINST_msg_ring_header_t *) MAP_FAILED) {
+      msg_ring_state = MSG_RING_FAILED;
+      return NULL;
+   }
+   if (hdr->magic != DYNINST_MSG_RING_MAGIC ||
+       hdr->num_rings != DYNINST_MSG_RING_COUNT ||
+       hdr->ring_bytes != DYNINST_MSG_RING_BYTES)
+   {
+      rtdebug_printf("%s[%d]: message ring layout mismatch\n",
+                     __FILE__, __LINE__);
+      munmap(hdr, sizeof(DYNINST_msg_ring_header_t));
+      msg_ring_state = MSG_RING_FAILED;
+      return NULL;
+   }
+
+   msg_ring_init_thread_exit();
+   msg_ring_hdr = hdr;
+   msg_ring_pid = getpid();
+   memcpy(msg_ring_parent_name, DYNINST_msg_ring_name, DYNINST_MSG_RING_NAME_LEN);
+   msg_ring_gen++;
+   __atomic_store_n(&msg_ring_state, MSG_RING_MAPPED, __ATOMIC_RELEASE);
+   return hdr;
+}
+
+static DYNINST_msg_ring_t *msg_ring_claim(DYNINST_msg_ring_header_t *hdr)
+{
+   int i;
+
+   if (msg_ring_slot_gen != msg_ring_gen) {
+      msg_ring_slot = 0;
+      msg_ring_slot_gen = msg_ring_gen;
+   }
+   if (msg_ring_slot > 0)
+      return &hdr->rings[msg_ring_slot - 1];
+   if (msg_ring_slot < 0)
+      return NULL;
+
+   /* Take the first ring that is free, reused or never claimed, so that
+      never-claimed rings stay at the end */
+   for (i = 0; i < DYNINST_MSG_RING_COUNT; i++) {
+      uint32_t owner = hdr->rings[i].owner;
+      if (owner == DYNINST_MSG_RING_OWNED)
+         continue;
+      if (__sync_bool_compare_and_swap(&hdr->rings[i].owner, owner,
+                                       DYNINST_MSG_RING_OWNED)) {
+         msg_ring_slot = i + 1;
+         if (msg_ring_setspecific)
+            msg_ring_setspecific(msg_ring_key, (void *) 1);
+         return &hdr->rings[i];
+      }
+   }
+   msg_ring_slot = -1;
+   return NULL;
+}
+
+static void msg_ring_copy(DYNINST_msg_ring_t *ring, uint32_t pos,
+                          const void *src, uint32_t len)
+{
+   uint32_t off = pos & (DYNINST_MSG_RING_BYTES - 1);
+   uint32_t first = DYNINST_MSG_RING_BYTES - off;
+
+   if (len <= first) {
+      memcpy(ring->data + off, src, len);
+   }
+   else {
+      memcpy(ring->data + off, src, first);
+      memcpy(ring->data, (const char *) src + first, len - first);
+   }
+}
+
+static int msg_ring_put(uint32_t type, const void *payload, uint32_t size)
+{
+   DYNINST_msg_ring_header_t *hdr;
+   DYNINST_msg_ring_t *ring;
+   DYNINST_msg_record_t rec;
+   uint32_t head, tail, need;
+
+   hdr = msg_ring_map();
+   if (!hdr) return 0;
+   ring = msg_ring_claim(hdr);
+   if (!ring) return 0;
+
+   if (size > DYNINST_MSG_RING_BYTES - sizeof(rec)) {
+      ring->overflows++;
+      return 0;
+   }
+   need = sizeof(rec) + ((size + 7) & ~7u);
+
+   tail = ring->tail;
+   head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+   if (DYNINST_MSG_RING_BYTES - (tail - head) < need) {
+      ring->overflows++;
+      return 0;
+   }
+
+   rec.type = type;
+   rec.size = size;
+   msg_ring_copy(ring, tail, &rec, sizeof(rec));
+   msg_ring_copy(ring, tail + sizeof(rec), payload, size);
+   __atomic_store_n(&ring->tail, tail + need, __ATOMIC_RELEASE);
+   return 1;
+}
+
+int DYNINSTmsgRingUserMessage(void *msg, unsigned int msg_size)
+{
+   return msg_ring_put(DSE_userMessage, msg, msg_size);
+}
+
+int DYNINSTmsgRingDynFuncCall(void *call_target, void *call_addr)
+{
+   DYNINST_msg_dynCallRecord_t rec;
+   rec.call_target = (uint64_t) (unsigned long) call_target;
+   rec.call_site_addr = (uint64_t) (unsigned long) call_addr;
+   return msg_ring_put(DSE_dynFuncCall, &rec, sizeof(rec));
+}
@@ -394,7 +394,7 @@ LONG dyn_trapHandler(PEXCEPTION_POINTERS e)
    void *trap_to=0;
    void *trap_addr = (void*) ((unsigned char*)e->ExceptionRecord->ExceptionAddress);
    unsigned long zero = 0;
-   unsigned long one = 1;
+   unsigned long layout;
    unsigned long loadAddr = 0;
    struct trap_mapping_header *hdr = NULL;
    trapMapping_t *mapping = NULL;
@@ -413,17 +413,20 @@ LONG dyn_trapHandler(PEXCEPTION_POINTERS e)
    hdr = getStaticTrapMap((unsigned long) trap_addr, &loadAddr);
    assert(hdr);
    mapping = &(hdr->traps[0]);
+   layout = (hdr->layout == DYNINST_TRAP_TABLE_HASHED) ?
+      DYNINST_TRAP_TABLE_HASHED : DYNINST_TRAP_TABLE_SORTED;
 
    rtdebug_printf("RTLIB: calling dyninstTrapTranslate(\n\t0x%lx, \n\t"
            "0x%lx, \n\t0x%lx, \n\t0x%lx, \n\t0x%lx)\n", 
            (unsigned long)trap_addr - loadAddr + 1, 
-           hdr->num_entries, zero, mapping, one);
+           hdr->num_entries, zero, mapping, layout);
 
    trap_to = dyninstTrapTranslate((void*)((unsigned long)trap_addr - loadAddr + 1),
                                   (unsigned long *) &hdr->num_entries,
                                   &zero, 
                                   (volatile trapMapping_t **) &mapping,
-                                  &one);
+                                  &layout,
+                                  0);
 
 #ifdef _WIN64
     rtdebug_printf("RTLIB: changing Rip from trap at 0x%lx to 0x%lx\n",
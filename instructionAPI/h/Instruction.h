@@ -35,6 +35,7 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <boost/container/small_vector.hpp>
 #include "Expression.h"
 #include "Operation_impl.h"
 #include "Operand.h"
@@ -271,7 +272,13 @@ namespace Dyninst
       /// and c_NoCategory, as defined in %InstructionCategories.h.
       INSTRUCTION_EXPORT InsnCategory getCategory() const;
 
-      typedef std::list<CFT>::const_iterator cftConstIter;
+      // Nearly every instruction has a handful of operands and at most two
+      // successors.  Keeping them inline means decoding an instruction does
+      // not allocate a list node per operand/successor.
+      typedef boost::container::small_vector<Operand, 5> operandList;
+      typedef boost::container::small_vector<CFT, 2> cftList;
+
+      typedef cftList::const_iterator cftConstIter;
       INSTRUCTION_EXPORT cftConstIter cft_begin() const {
           return m_Successors.begin();
       }
@@ -308,13 +315,13 @@ namespace Dyninst
       void addSuccessor(Expression::Ptr e, bool isCall, bool isIndirect, bool isConditional, bool isFallthrough) const;
       void copyRaw(size_t size, const unsigned char* raw);
       Expression::Ptr makeReturnExpression() const;
-      mutable std::list<Operand> m_Operands;
+      mutable operandList m_Operands;
       mutable Operation m_InsnOp;
       bool m_Valid;
       raw_insn_T m_RawInsn;
       unsigned int m_size;
       Architecture arch_decoded_from;
-      mutable std::list<CFT> m_Successors;
+      mutable cftList m_Successors;
       static int numInsnsAllocated;
       ArchSpecificFormatter& formatter;
     };
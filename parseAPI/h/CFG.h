@@ -412,6 +412,7 @@ class PARSER_EXPORT Function : public AnnotatableSparse, public boost::lockable_
     
     FuncSource _src;
     boost::atomic<FuncReturnStatus> _rs;
+    boost::atomic<unsigned> _cfg_version;
 
     std::string _name;
     Block * _entry;
@@ -549,9 +550,15 @@ class PARSER_EXPORT Function : public AnnotatableSparse, public boost::lockable_
     /* Contiguous code segments of function */
     std::vector<FuncExtent *> const& extents();
 
-    /* This should not remain here - this is an experimental fix for
-       defensive mode CFG inconsistency */
-    void invalidateCache() { _cache_valid = false; }
+    /* Marks the function's blocks as out of date.  Loop and dominator
+       information is dropped immediately; the function itself is
+       re-finalized on the next query or by CodeObject::finalize(). */
+    void invalidateCache();
+
+    /* Incremented every time invalidateCache() is called, so that
+       analyses cached outside ParseAPI can tell that the CFG they
+       were computed on has changed */
+    unsigned cfgVersion() const { return _cfg_version.load(); }
     inline std::pair<Address, Block*> get_next_block(
             Address addr,
             CodeRegion *codereg) const;
@@ -564,6 +571,7 @@ class PARSER_EXPORT Function : public AnnotatableSparse, public boost::lockable_
  private:
     void delayed_link_return(CodeObject * co, Block * retblk);
     void finalize();
+    void invalidate_analyses();
 
     bool _parsed;
     //    blocklist _bl;
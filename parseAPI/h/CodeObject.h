@@ -42,6 +42,9 @@
 #include "ParseContainers.h"
 
 namespace Dyninst {
+
+class AssignmentCache;
+
 namespace ParseAPI {
 
 /** A CodeObject defines a collection of binary code, for example a binary,
@@ -54,6 +57,7 @@ class ParseCallback;
 class ParseCallbackManager;
 class CFGModifier;
 class CodeSource;
+class InsnCache;
 
 typedef enum {
     PreambleMatching, IdiomMatching
@@ -133,6 +137,25 @@ class CodeObject {
 
     PARSER_EXPORT bool isIATcall(Address insn, std::string &calleeName);
 
+    /*
+     * Block::getInsns and Block::getInsn can keep the decoded
+     * instructions of recently used blocks instead of re-decoding them
+     * on every call.  The cache is off unless enabled here or with
+     * DYNINST_INSN_CACHE=<max blocks>; a size of 0 turns it off.
+     * Resizing drops the cached blocks and must not race with other
+     * threads using this CodeObject.  Hits are decodes avoided.
+     */
+    PARSER_EXPORT void setInsnCacheSize(size_t maxBlocks);
+    PARSER_EXPORT void getInsnCacheStats(unsigned long &hits,
+                                         unsigned long &misses) const;
+
+    /*
+     * Instruction-to-Assignment conversions shared by the slicers run
+     * over this object, e.g. for every jump table.  NULL if disabled
+     * with DYNINST_NO_ASSIGNMENT_CACHE.
+     */
+    PARSER_EXPORT AssignmentCache * assignmentCache() const { return assign_cache; }
+
     // This is for callbacks; it is often much more efficient to 
     // batch callbacks and deliver them all at once than one at a time. 
     // Particularly if we're deleting code, it's better to get
@@ -173,8 +196,13 @@ class CodeObject {
     friend void Function::delayed_link_return(CodeObject *,Block*);
     // allows Functions to finalize (need Parser access)
     friend void Function::finalize();
+    // allows Functions to queue themselves for re-finalization
+    friend void Function::invalidateCache();
     // allows Function entry blocks to be moved to new regions
     friend void Function::setEntryBlock(Block *);
+    // allows Blocks to use the decoded instruction cache
+    friend class Block;
+    InsnCache * insnCache() const { return insn_cache; }
 
     void getATFunctionsInDataSection(const char*, std::set<Function*>&, std::map<Address, Function*>&);
     void getATFunctionsInCodeSection(std::set<Function*>&at, std::map<Address, Function*>&);
@@ -192,6 +220,9 @@ class CodeObject {
     bool owns_factory;
     bool defensive;
     funclist& flist;
+
+    InsnCache * insn_cache;
+    AssignmentCache * assign_cache;
 };
 
 // We need CFG.h, which is included by this
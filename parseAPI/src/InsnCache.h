@@ -0,0 +1,111 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _INSN_CACHE_H_
+#define _INSN_CACHE_H_
+
+#include <utility>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "dyntypes.h"
+#include "Instruction.h"
+#include "common/src/lru_cache.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class Block;
+class CodeRegion;
+
+/*
+ * Per-CodeObject cache of decoded block instructions, used by
+ * Block::getInsns and Block::getInsn.  Each entry holds a block's
+ * instructions sorted by offset; the cache is bounded by a number of
+ * blocks and evicts least recently used entries.
+ *
+ * Entries remember the region and extent they were decoded from, so a
+ * block that has been split or freed and reallocated simply misses.
+ * The cached Instructions are never asked for their operands; callers
+ * get copies, which decode lazily on their own.
+ */
+class InsnCache {
+ public:
+    typedef std::vector<std::pair<Offset, InstructionAPI::Instruction> > InsnList;
+    typedef boost::shared_ptr<const InsnList> InsnListPtr;
+
+    InsnCache(size_t maxBlocks) : cache(maxBlocks), hits(0), misses(0) {}
+
+    InsnListPtr lookup(const Block *b, CodeRegion *r, Address start, Address end)
+    {
+        Entry e;
+        if (cache.lookup(b, e) && e.region == r &&
+            e.start == start && e.end == end) {
+            hits.fetch_add(1, boost::memory_order_relaxed);
+            return e.insns;
+        }
+        misses.fetch_add(1, boost::memory_order_relaxed);
+        return InsnListPtr();
+    }
+
+    void insert(const Block *b, CodeRegion *r, Address start, Address end,
+                InsnListPtr insns)
+    {
+        Entry e;
+        e.region = r;
+        e.start = start;
+        e.end = end;
+        e.insns = insns;
+        cache.insert(b, e);
+    }
+
+    size_t capacity() const { return cache.capacity(); }
+    unsigned long numHits() const { return hits.load(); }
+    unsigned long numMisses() const { return misses.load(); }
+
+ private:
+    struct Entry {
+        CodeRegion *region;
+        Address start;
+        Address end;
+        InsnListPtr insns;
+    };
+
+    ConcurrentLRUCache<const Block *, Entry, boost::hash<const Block *> > cache;
+    boost::atomic<unsigned long> hits;
+    boost::atomic<unsigned long> misses;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _PARSE_CACHE_H_
+#define _PARSE_CACHE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "dyntypes.h"
+
+class MappedFile;
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class CodeSource;
+
+/*
+ * On-disk image of a finalized CFG.
+ *
+ * The cache is enabled by setting DYNINST_PARSE_CACHE to a directory;
+ * an empty value places the cache next to the binary. Files are keyed
+ * by the ELF build-id and are rejected if the Dyninst version or the
+ * set of parsing hints differs from the one that produced them.
+ *
+ * All records are fixed-size and 8-byte aligned so a loaded cache is
+ * used in place from the mapped file.
+ */
+class ParseCache {
+ public:
+    static const uint32_t NO_INDEX = 0xffffffffU;
+
+    struct Header {
+        char magic[8];
+        uint32_t format;
+        uint32_t major;
+        uint32_t minor;
+        uint32_t patch;
+        uint64_t hint_hash;
+        uint64_t num_funcs;
+        uint64_t num_blocks;
+        uint64_t num_edges;
+        uint64_t num_jump_tables;
+        uint64_t num_jump_entries;
+        uint64_t strtab_size;
+    };
+
+    struct FuncRec {
+        uint64_t addr;
+        uint64_t tamper_addr;
+        uint64_t ret_addr;
+        uint32_t entry;         // index into the block table
+        uint32_t name;          // offset into the string table
+        uint8_t src;            // FuncSource
+        uint8_t retstatus;      // FuncReturnStatus
+        uint8_t tamper;         // StackTamper
+        uint8_t flags;
+        uint32_t pad;
+    };
+    enum {
+        F_NO_STACK_FRAME = 0x1,
+        F_SAVES_FP = 0x2,
+        F_CLEANS_STACK = 0x4,
+        F_LEAF = 0x8
+    };
+
+    struct BlockRec {
+        uint64_t start;
+        uint64_t end;
+        uint64_t last;
+        uint32_t creator;       // index into the function table
+        uint32_t pad;
+    };
+
+    struct EdgeRec {
+        uint32_t src;
+        uint32_t trg;           // NO_INDEX for sink edges
+        uint8_t type;           // EdgeTypeEnum
+        uint8_t interproc;
+        uint8_t pad[6];
+    };
+
+    struct JumpTableRec {
+        uint64_t jump_addr;
+        uint64_t table_start;
+        uint64_t table_end;
+        uint64_t first_entry;   // index into the jump table entry table
+        uint64_t num_entries;
+        uint32_t block;
+        int32_t index_stride;
+        int32_t memory_read_size;
+        uint32_t zero_extend;
+    };
+
+    struct JumpEntryRec {
+        uint64_t slot;
+        uint64_t target;
+    };
+
+    ParseCache(CodeSource *cs);
+    ~ParseCache();
+
+    // True if caching is requested and the binary has a usable key
+    bool enabled() const { return !_path.empty(); }
+    const std::string &path() const { return _path; }
+
+    // Map the cache file; fails if it is missing or stale
+    bool load(uint64_t hint_hash);
+
+    // Tables of a loaded cache
+    const Header &header() const { return *_hdr; }
+    const FuncRec *funcs() const { return _funcs; }
+    const BlockRec *blocks() const { return _blocks; }
+    const EdgeRec *edges() const { return _edges; }
+    const JumpTableRec *jumpTables() const { return _jts; }
+    const JumpEntryRec *jumpEntries() const { return _jes; }
+    const char *name(uint32_t off) const { return _strtab + off; }
+
+    // Tables of a cache to be written
+    std::vector<FuncRec> out_funcs;
+    std::vector<BlockRec> out_blocks;
+    std::vector<EdgeRec> out_edges;
+    std::vector<JumpTableRec> out_jts;
+    std::vector<JumpEntryRec> out_jes;
+
+    uint32_t addName(const std::string &n);
+    bool save(uint64_t hint_hash);
+
+    static uint64_t hashHints(CodeSource *cs);
+
+ private:
+    bool findBuildId(CodeSource *cs, std::string &id, std::string &file);
+
+    std::string _path;
+    MappedFile *_mf;
+    std::string _strings;
+
+    const Header *_hdr;
+    const FuncRec *_funcs;
+    const BlockRec *_blocks;
+    const EdgeRec *_edges;
+    const JumpTableRec *_jts;
+    const JumpEntryRec *_jes;
+    const char *_strtab;
+};
+
+}
+}
+
+#endif
@@ -61,7 +61,7 @@ class ParseData;
 
 /** Describes a saved frame during recursive parsing **/
 // Parsing data for a function. 
-class ParseFrame : public boost::lockable_adapter<boost::recursive_mutex> {
+class ParseFrame {
  public:
     enum Status {
         UNPARSED,
@@ -142,6 +142,12 @@ class ParseFrame : public boost::lockable_adapter<boost::recursive_mutex> {
     ParseWorkElem * seed; // stored for cleanup
     std::set<Address> value_driven_jump_tables;
 
+    // Lockable.  Acquisitions that have to wait for another thread are
+    // counted in the owning ParseData.
+    void lock();
+    void unlock() { _mutex.unlock(); }
+    bool try_lock() { return _mutex.try_lock(); }
+
     ParseFrame(Function * f,ParseData *pd) :
         curAddr(0),
         num_insns(0),
@@ -162,6 +168,7 @@ class ParseFrame : public boost::lockable_adapter<boost::recursive_mutex> {
     void set_status(Status);
     void set_internal_status(Status s) { _status.store(s); } 
  private:
+    boost::recursive_mutex _mutex;
     boost::atomic<Status> _status;
     ParseData * _pd;
 };
@@ -179,24 +186,29 @@ class edge_parsing_data {
 };
 
 
-/* per-CodeRegion parsing data */
+/* per-CodeRegion parsing data
+ *
+ * The address-keyed maps are written by every parsing thread, so they
+ * are striped by address.  The range trees are only filled in once
+ * parsing is done (Parser::finalize_ranges).
+ */
 class region_data {
 public:
     // Function lookups
     Dyninst::IBSTree_fast<FuncExtent> funcsByRange;
-    dyn_c_hash_map<Address, Function *> funcsByAddr;
+    dyn_c_striped_hash_map<Address, Function *> funcsByAddr;
 
     // Block lookups
     Dyninst::IBSTree_fast<Block > blocksByRange;
-    dyn_c_hash_map<Address, Block *> blocksByAddr;
+    dyn_c_striped_hash_map<Address, Block *> blocksByAddr;
 
     // Parsing internals 
-    dyn_c_hash_map<Address, ParseFrame *> frame_map;
-    dyn_c_hash_map<Address, ParseFrame::Status> frame_status;
+    dyn_c_striped_hash_map<Address, ParseFrame *> frame_map;
+    dyn_c_striped_hash_map<Address, ParseFrame::Status> frame_status;
 
     // Edge parsing records
     // We only want one thread to create edges for a location
-    typedef dyn_c_hash_map<Address, edge_parsing_data> edge_data_map;
+    typedef dyn_c_striped_hash_map<Address, edge_parsing_data> edge_data_map;
     edge_data_map edge_parsing_status;
 
     Function * findFunc(Address entry);
@@ -280,6 +292,9 @@ public:
     }
     void insertBlockByRange(Block* b) {
         blocksByRange.insert(b);
+    }
+    void insertBlocksByRange(std::vector<Block*> &blocks) {
+        blocksByRange.insert(blocks.begin(), blocks.end());
     }
 	 // Find functions within [start,end)
 	 int findFuncs(Address start, Address end, set<Function *> & funcs);
@@ -375,11 +390,22 @@ region_data::findBlocks(Address addr, set<Block *> & blocks)
 
 class ParseData {
  protected:
-    ParseData(Parser *p) : _parser(p) { }
+    ParseData(Parser *p) : _parser(p) {
+        frame_lock_waits.store(0);
+        block_conflicts.store(0);
+        edge_conflicts.store(0);
+    }
     Parser * _parser;
  public:
     virtual ~ParseData() { }
 
+    // Contention on shared parse state, reported in the parse statistics:
+    // frame locks that had to wait, and blocks or edges another thread
+    // had already claimed
+    boost::atomic<unsigned long> frame_lock_waits;
+    boost::atomic<unsigned long> block_conflicts;
+    boost::atomic<unsigned long> edge_conflicts;
+
     //
     virtual Function * findFunc(CodeRegion *, Address) =0;
     virtual Block * findBlock(CodeRegion *, Address) =0;
@@ -471,7 +497,9 @@ inline Function* StandardParseData::record_func(Function *f)
 }
 inline Block* StandardParseData::record_block(CodeRegion * /* cr */, Block *b)
 {
-    return _rdata.record_block(b);
+    Block *ret = _rdata.record_block(b);
+    if (ret != b) block_conflicts.fetch_add(1, boost::memory_order_relaxed);
+    return ret;
 }
 
 inline edge_parsing_data StandardParseData::setEdgeParsingStatus(CodeRegion *, Address addr, Function *f, Block *b)
@@ -530,6 +558,14 @@ class OverlappingParseData : public ParseData {
 
 };
 
+inline void ParseFrame::lock()
+{
+    if (!_mutex.try_lock()) {
+        _pd->frame_lock_waits.fetch_add(1, boost::memory_order_relaxed);
+        _mutex.lock();
+    }
+}
+
 }
 }
 
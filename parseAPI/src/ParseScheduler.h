@@ -0,0 +1,127 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _PARSE_SCHEDULER_H_
+#define _PARSE_SCHEDULER_H_
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include <boost/atomic.hpp>
+
+#include "concurrent.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * Runs the Parser's parallel phases: frame parsing, jump table
+ * finalization and function finalization.  A task may spawn further
+ * tasks while run() is active; run() returns once the root task and
+ * everything it transitively spawned have completed.
+ *
+ * The implementation is chosen with DYNINST_PARSE_SCHEDULER:
+ * "steal" (the default) uses per-worker deques with work stealing,
+ * "omp" uses OpenMP tasks and worksharing loops.  Both size themselves
+ * from omp_get_max_threads(), so OMP_NUM_THREADS still controls the
+ * number of parsing threads.
+ */
+class ParseScheduler {
+public:
+    typedef std::function<void()> Task;
+    typedef std::function<void(size_t)> LoopBody;
+
+    struct Stats {
+        Stats() : tasks(0), steals(0) {}
+        unsigned long tasks;    // tasks executed
+        unsigned long steals;   // tasks taken from another worker's deque
+    };
+
+    virtual ~ParseScheduler() {}
+
+    virtual void run(const Task &root) = 0;
+
+    // Only valid from within a task started by run()
+    virtual void spawn(const Task &t) = 0;
+
+    // Calls body(i) for every i in [0, n)
+    virtual void parallel_for(size_t n, const LoopBody &body) = 0;
+
+    // Returns the statistics gathered since the last call
+    virtual Stats takeStats() { return Stats(); }
+
+    static ParseScheduler *create();
+};
+
+class OmpTaskScheduler : public ParseScheduler {
+public:
+    void run(const Task &root);
+    void spawn(const Task &t);
+    void parallel_for(size_t n, const LoopBody &body);
+};
+
+class WorkStealingScheduler : public ParseScheduler {
+public:
+    WorkStealingScheduler();
+    ~WorkStealingScheduler();
+
+    void run(const Task &root);
+    void spawn(const Task &t);
+    void parallel_for(size_t n, const LoopBody &body);
+    Stats takeStats();
+
+private:
+    // The owner pushes and pops at the back, so it works depth-first on
+    // the frames it just discovered; thieves take the oldest task from
+    // the front, which tends to be the largest remaining piece of work.
+    struct Worker {
+        Worker() : executed(0), stolen(0) {}
+        dyn_mutex lock;
+        std::deque<Task> tasks;
+        unsigned long executed;
+        unsigned long stolen;
+    };
+
+    void ensureWorkers(unsigned n);
+    bool popLocal(Worker *w, Task &t);
+    bool steal(unsigned self, Task &t);
+    void workerLoop(unsigned self);
+
+    // Serializes independent calls to run()
+    dyn_mutex run_lock_;
+    std::vector<Worker *> workers_;
+    unsigned active_;
+    boost::atomic<long> pending_;
+};
+
+}
+}
+
+#endif
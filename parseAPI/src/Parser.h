@@ -48,6 +48,7 @@
 #include "CodeObject.h"
 #include "CFG.h"
 #include "ParseCallback.h"
+#include "ParseScheduler.h"
 
 #include "common/src/dthread.h"
 #include <boost/thread/lockable_adapter.hpp>
@@ -83,6 +84,9 @@ namespace Dyninst {
             // region data store
             ParseData *_parse_data;
 
+            // runs frame parsing and the parallel finalization loops
+            ParseScheduler *_sched;
+
             // All allocated frames
             LockFreeQueue<ParseFrame *> frames;
 
@@ -172,6 +176,10 @@ namespace Dyninst {
 
             bool finalize(Function *f);
 
+            // deferred: f's analyses still have to be dropped (see
+            // defer_invalidate)
+            void mark_modified(Function *f, bool deferred = false);
+
             ParseData *parse_data() { return _parse_data; }
 
         private:
@@ -254,7 +262,14 @@ namespace Dyninst {
 
             void finalize();
 
+            // on-disk CFG cache
+            bool load_cache();
+            void save_cache();
+
+            void finalize_funcs();
             void finalize_funcs(dyn_c_vector<Function *> &funcs);
+            void finalize_modified();
+            void defer_invalidate(Function *f);
 	    void clean_bogus_funcs(dyn_c_vector<Function*> &funcs);
             void finalize_ranges();
             void finalize_jump_tables();
@@ -286,6 +301,8 @@ namespace Dyninst {
 
     void LaunchWork(LockFreeQueueItem<ParseFrame*> *frame_list, bool recursive);
 
+    void record_parallel_stats();
+
 
     void processCycle(LockFreeQueue<ParseFrame *> &work, bool recursive);
 
@@ -302,6 +319,13 @@ namespace Dyninst {
             // Note: this has to be run in a single thread.
             std::set<Function*> funcs_to_ranges;
 
+            // Previously finalized functions whose blocks have changed since
+            // (see Function::invalidateCache).  finalize() re-finalizes just
+            // these instead of every function in the CodeObject.  The value
+            // is true if the function was invalidated during parsing and its
+            // loop and dominator information has not been dropped yet.
+            dyn_c_hash_map<Function*, bool> modified_funcs;
+
             dyn_c_hash_map<Block*, std::set<Function* > > funcsByBlockMap;
             dyn_c_hash_map<Address, Function::JumpTableInstance> jumpTableMap;
         };
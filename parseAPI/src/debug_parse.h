@@ -76,6 +76,15 @@ extern const std::string PARSE_JUMPTABLE_FAIL;
 extern const std::string PARSE_TAILCALL_COUNT;
 extern const std::string PARSE_TAILCALL_FAIL;
 
+extern const std::string PARSE_INSN_DECODE_COUNT;
+extern const std::string PARSE_INSN_DECODE_SAVED;
+
+extern const std::string PARSE_SCHED_TASKS;
+extern const std::string PARSE_SCHED_STEALS;
+extern const std::string PARSE_FRAME_LOCK_WAITS;
+extern const std::string PARSE_BLOCK_CONFLICTS;
+extern const std::string PARSE_EDGE_CONFLICTS;
+
 extern const std::string PARSE_TOTAL_TIME;
 extern const std::string PARSE_JUMPTABLE_TIME;
 
@@ -471,6 +471,21 @@ class PC_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool writeMemory(Dyninst::Address addr, const void *buffer, size_t size) const;
    bool readMemory(void *buffer, Dyninst::Address addr, size_t size) const;
 
+   /**
+    * Vectored read.  Each entry is read into its own buffer and gets its
+    * own error code.  On platforms that support it the whole vector is
+    * transferred with as few system calls as possible, which makes this
+    * the preferred way to pull many small pieces (e.g. stack frames) out
+    * of a stopped process.
+    **/
+   struct mem_read_t {
+      Dyninst::Address addr;
+      void *buffer;
+      size_t size;
+      err_t err;
+   };
+   bool readMemoryV(std::vector<mem_read_t> &reads) const;
+
    bool writeMemoryAsync(Dyninst::Address addr, const void *buffer, size_t size, void *opaque_val = NULL) const;
    bool readMemoryAsync(void *buffer, Dyninst::Address addr, size_t size, void *opaque_val = NULL) const;
 
@@ -432,6 +432,12 @@ class int_process
 
    virtual bool plat_readMem(int_thread *thr, void *local,
                              Dyninst::Address remote, size_t size) = 0;
+
+   //Synchronous vectored read.  The default implementation issues one
+   // plat_readMem per entry; platforms with a scatter/gather interface
+   // should override it.
+   bool readMemV(std::vector<Process::mem_read_t> &reads, int_thread *thr = NULL);
+   virtual bool plat_readMemV(int_thread *thr, std::vector<Process::mem_read_t> &reads);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write) = 0;
 
@@ -131,6 +131,7 @@ class linux_process : public sysv_process, public unix_process, public thread_db
 
    virtual bool plat_readMem(int_thread *thr, void *local,
                              Dyninst::Address remote, size_t size);
+   virtual bool plat_readMemV(int_thread *thr, std::vector<Process::mem_read_t> &reads);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write);
    virtual SymbolReaderFactory *plat_defaultSymReader();
@@ -158,6 +159,17 @@ class linux_process : public sysv_process, public unix_process, public thread_db
 
   protected:
    int computeAddrWidth();
+
+   //Memory access goes through process_vm_readv/writev when the kernel
+   // allows it, then through a /proc/<pid>/mem descriptor that is opened
+   // once and kept until exec/detach, and finally through ptrace.
+   bool readProcessVM(void *local, Dyninst::Address remote, size_t size);
+   bool writeProcessVM(const void *local, Dyninst::Address remote, size_t size);
+   int getMemFD();
+   void closeMemFD();
+
+   int mem_fd;
+   Mutex<> mem_fd_lock;
 };
 
 class linux_x86_process : public linux_process, public x86_process
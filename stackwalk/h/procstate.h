@@ -127,6 +127,12 @@ class SW_EXPORT ProcDebug : public ProcessState {
    ProcDebug(Dyninst::ProcControlAPI::Process::ptr p);
 
    std::set<Dyninst::ProcControlAPI::Thread::ptr> needs_resume;
+
+   //Stack pages prefetched by a parallel WalkerSet walk, keyed by page
+   // address.  Only populated while the process is held stopped.
+   friend class int_walkerSet;
+   std::map<Dyninst::Address, std::vector<unsigned char> > stack_pages;
+   bool readStackPages(void *dest, Dyninst::Address source, size_t size);
  public:
   
   static ProcDebug *newProcDebug(Dyninst::PID pid, std::string executable="");
@@ -127,6 +127,13 @@ class SW_EXPORT Walker {
    //Set the default symbol reader
    static void setSymbolReader(SymbolReaderFactory *srf);
 
+   //Sampling mode: unwind rules derived from debug info are memoized in a
+   // cache shared by every walker and thread of a process, holding at most
+   // max_entries rules per process (0 picks the default).  Can also be
+   // enabled with DYNINST_STACKWALK_SAMPLING=<max_entries>.
+   static void setSamplingMode(bool enable, unsigned max_entries = 0);
+   static bool getSamplingMode();
+
    //Collect a stackwalk
    bool walkStack(std::vector<Frame> &stackwalk, 
                   Dyninst::THR_ID thread = NULL_THR_ID);
@@ -193,6 +200,17 @@ class SW_EXPORT WalkerSet {
    size_t size() const;
 
    bool walkStacks(CallTree &tree, bool walk_initial_only = false) const;
+
+   //Have walkStacks use up to num_workers threads.  All processes are
+   // stopped at once, their stack memory is prefetched in bulk, and then
+   // each worker unwinds every thread of the processes it picks up.
+   // 0 or 1 (the default) walks serially.
+   void setParallelWalk(unsigned num_workers);
+   unsigned getParallelWalk() const;
+
+   //Microseconds from stopping the processes until every stack had been
+   // collected, for the last parallel walkStacks.
+   unsigned long getLastSnapshotTime() const;
 };
 
 }
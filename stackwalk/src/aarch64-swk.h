@@ -7,6 +7,7 @@
 #include "common/h/dyntypes.h"
 
 #include "common/src/lru_cache.h"
+#include "common/h/concurrent.h"
 
 namespace Dyninst {
 namespace Stackwalker {
@@ -15,6 +16,8 @@ class aarch64_LookupFuncStart : public FrameFuncHelper
 {
 private:
    static std::map<Dyninst::PID, aarch64_LookupFuncStart*> all_func_starts;
+   //Guards all_func_starts and ref_count
+   static dyn_mutex func_starts_lock;
    aarch64_LookupFuncStart(ProcessState *proc_);
    int ref_count;
 
@@ -23,6 +26,7 @@ private:
    // We need some kind of re-entrant safe synhronization before we can
    // globally turn this caching on, but it would sure help things.
    static const unsigned int cache_size = 64;
+   dyn_mutex cache_lock;
    LRUCache<Address, FrameFuncHelper::alloc_frame_t> cache;
 public:
    static aarch64_LookupFuncStart *getLookupFuncStart(ProcessState *p);
@@ -33,6 +33,7 @@
 
 #include "stackwalk/h/framestepper.h"
 #include "common/h/ProcReader.h"
+#include "stackwalk/src/unwind_cache.h"
 
 namespace Dyninst {
 
@@ -57,6 +58,13 @@ class DebugStepperImpl : public FrameStepper, public Dyninst::ProcessReader {
 
     dyn_hash_map<Address, cache_t> cache_;
 
+    // In sampling mode rules live in the process-wide UnwindCache
+    // instead of cache_.
+    UnwindCache::ptr shared_cache;
+    Address cur_lib_base;
+    bool findCacheEntry(Address ra, cache_t &entry);
+    void storeCacheEntry(Address ra, const cache_t &entry);
+
     void addToCache(const Frame &cur, const Frame &caller);
     bool lookupInCache(const Frame &cur, Frame &caller);
 
@@ -73,6 +81,7 @@ class DebugStepperImpl : public FrameStepper, public Dyninst::ProcessReader {
   virtual gcframe_ret_t getCallerFrame(const Frame &in, Frame &out);
   virtual unsigned getPriority() const;
   virtual void registerStepperGroup(StepperGroup *group);
+  virtual void newLibraryNotification(LibAddrPair *la, lib_change_t change);
   virtual bool ReadMem(Address addr, void *buffer, unsigned size);
   virtual bool GetReg(MachRegister reg, MachRegisterVal &val);
   virtual ~DebugStepperImpl();  
@@ -33,6 +33,7 @@
 
 #include <set>
 #include "common/src/addrRange.h"
+#include "common/h/concurrent.h"
 #include "stackwalk/h/framestepper.h"
 #include "stackwalk/h/procstate.h"
 #include "stackwalk/h/walker.h"
@@ -107,6 +108,7 @@ public:
 class DyninstInstrStepperImpl : public FrameStepper {
  private:
    static std::map<SymReader *, bool> isRewritten;
+   static dyn_mutex isRewritten_lock;
    DyninstInstrStepper *parent;
 
  public:
@@ -178,8 +180,11 @@ private:
    void clearProcSet();
    void initProcSet();
    bool walkStacksProcSet(CallTree &tree, bool &bad_plat, bool walk_iniital_only);
+   bool walkStacksParallel(CallTree &tree, bool &bad_plat, bool walk_initial_only);
 
    unsigned non_pd_walkers;
+   unsigned num_workers;
+   unsigned long last_snapshot_usecs;
    set<Walker *> walkers;
    void *procset; //Opaque pointer, will refer to a ProcControl::ProcessSet in some situations
 };
@@ -0,0 +1,107 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(UNWIND_CACHE_H_)
+#define UNWIND_CACHE_H_
+
+#include "common/h/dyntypes.h"
+#include "common/h/concurrent.h"
+#include <boost/shared_ptr.hpp>
+#include <deque>
+
+namespace Dyninst {
+namespace Stackwalker {
+
+class ProcessState;
+
+/**
+ * Memoized unwind rules shared by every walker and thread of one process.
+ *
+ * Only used in sampling mode (Walker::setSamplingMode or the
+ * DYNINST_STACKWALK_SAMPLING environment variable).  A rule maps a
+ * return address to the deltas from the frame's SP to the caller's
+ * RA slot, FP slot and SP, which is what DebugStepper re-derives from
+ * DWARF every time otherwise.  Rules remember the load address of the
+ * library they came from so an unload can drop them.
+ *
+ * The table is split into shards, each with its own lock and a FIFO
+ * that bounds its size, so concurrent samplers rarely contend.
+ **/
+class UnwindCache {
+ public:
+   typedef boost::shared_ptr<UnwindCache> ptr;
+
+   struct rule_t {
+      unsigned ra_delta;
+      unsigned fp_delta;
+      unsigned sp_delta;
+      Address lib_base;
+   };
+
+   //Returns the cache for proc's pid, or an empty pointer when
+   // sampling mode is off.
+   static ptr getCache(ProcessState *proc);
+   static void releaseCache(Dyninst::PID pid);
+
+   static void setSamplingMode(bool enable, unsigned max_entries);
+   static bool samplingMode();
+
+   bool lookup(Address ra, rule_t &rule);
+   void insert(Address ra, const rule_t &rule);
+   void invalidateLibrary(Address lib_base);
+
+   UnwindCache(Dyninst::PID pid, unsigned max_entries);
+   ~UnwindCache();
+
+ private:
+   static const unsigned NUM_SHARDS = 16;
+
+   struct shard_t {
+      dyn_mutex lock;
+      dyn_hash_map<Address, rule_t> rules;
+      std::deque<Address> order;
+   };
+
+   shard_t &shardFor(Address ra) { return shards[(ra >> 4) % NUM_SHARDS]; }
+
+   Dyninst::PID pid;
+   unsigned shard_capacity;
+   shard_t shards[NUM_SHARDS];
+
+   boost::atomic<unsigned long> hits;
+   boost::atomic<unsigned long> misses;
+   boost::atomic<unsigned long> evictions;
+   boost::atomic<unsigned long> invalidations;
+};
+
+}
+}
+
+#endif
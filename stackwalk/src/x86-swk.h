@@ -36,6 +36,7 @@
 #include "common/h/dyntypes.h"
 
 #include "common/src/lru_cache.h"
+#include "common/h/concurrent.h"
 
 namespace Dyninst {
 namespace Stackwalker {
@@ -62,6 +63,8 @@ class LookupFuncStart : public FrameFuncHelper
 {
 private:
    static std::map<Dyninst::PID, LookupFuncStart*> all_func_starts;
+   //Guards all_func_starts and ref_count
+   static dyn_mutex func_starts_lock;
    LookupFuncStart(ProcessState *proc_);
    int ref_count;
 
@@ -70,6 +73,7 @@ private:
    //We need some kind of re-entrant safe synhronization before we can
    // globally turn this caching on, but it would sure help things.
    static const unsigned int cache_size = 64;
+   dyn_mutex cache_lock;
    LRUCache<Address, alloc_frame_t> cache;
 public:
    static LookupFuncStart *getLookupFuncStart(ProcessState *p);
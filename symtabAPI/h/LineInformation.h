@@ -31,6 +31,11 @@
 #if ! defined( LINE_INFORMATION_H )
 #define LINE_INFORMATION_H
 
+#include <deque>
+#include <map>
+#include <vector>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/shared_ptr.hpp>
 #include "symutil.h"
 #include "RangeLookup.h"
 #include "Annotatable.h"
@@ -41,15 +46,59 @@
 namespace Dyninst{
 namespace SymtabAPI{
 
-class SYMTAB_EXPORT LineInformation : 
-                        private RangeLookupTypes< Statement >::type
+/* Line rows are kept as a struct of arrays sorted by address: start
+ * addresses, 32-bit lengths, file indices into the module's string
+ * table, and line/column numbers stored as 16-bit deltas from a
+ * per-block base.  Rows added since the last query are staged and
+ * merged in on the next lookup.  Statement objects are only built when
+ * a row is handed out, are shared by every row with the same contents,
+ * and stay valid for the life of the table.
+ *
+ * Iterators are invalidated by addLine, addAddressRange and addLineInfo:
+ * the merge on the next lookup renumbers the rows, so an older iterator
+ * may then name a different row.  It remains safe to dereference (rows
+ * are never dropped, and a by-source iterator keeps its own ordering
+ * alive), but callers that add lines must re-fetch their iterators. */
+class SYMTAB_EXPORT LineInformation
 {
 public:
-    typedef RangeLookupTypes< Statement> traits;
-    typedef RangeLookupTypes< Statement >::type impl_t;
-    typedef impl_t::index<Statement::addr_range>::type::const_iterator const_iterator;
-    typedef impl_t::index<Statement::line_info>::type::const_iterator const_line_info_iterator;
-    typedef traits::value_type Statement_t;
+    typedef Statement::Ptr Statement_t;
+
+    /* Walks rows in address order, or in (file, line) order through a
+       permutation; dereferencing materializes the row's Statement. */
+    typedef boost::shared_ptr<const std::vector<uint32_t> > Order;
+
+    class SYMTAB_EXPORT const_iterator :
+        public boost::iterator_facade<const_iterator, Statement_t,
+                                      boost::random_access_traversal_tag,
+                                      Statement_t>
+    {
+    public:
+        const_iterator() : owner_(NULL), pos_(0) {}
+    private:
+        friend class LineInformation;
+        friend class boost::iterator_core_access;
+        const_iterator(const LineInformation *owner, const Order &order, size_t pos) :
+            owner_(owner), order_(order), pos_(pos) {}
+
+        Statement_t dereference() const;
+        bool equal(const const_iterator &other) const {
+            return owner_ == other.owner_ && order_ == other.order_ && pos_ == other.pos_;
+        }
+        void increment() { ++pos_; }
+        void decrement() { --pos_; }
+        void advance(std::ptrdiff_t n) { pos_ += n; }
+        std::ptrdiff_t distance_to(const const_iterator &other) const {
+            return (std::ptrdiff_t) other.pos_ - (std::ptrdiff_t) pos_;
+        }
+        size_t row() const { return order_ ? (*order_)[pos_] : pos_; }
+
+        const LineInformation *owner_;
+        Order order_;
+        size_t pos_;
+    };
+    typedef const_iterator const_line_info_iterator;
+
       LineInformation();
 
       /* You MAY freely deallocate the lineSource strings you pass in. */
@@ -102,6 +151,73 @@ public:
 protected:
     mutable int wasted_compares;
     mutable int num_queries;
+
+private:
+    struct Row {
+        Offset start;
+        Offset end;
+        unsigned int file;
+        unsigned int line;
+        unsigned int column;
+        bool operator<(const Row &o) const;
+        bool operator==(const Row &o) const;
+    };
+
+    /* uint32 values as a per-block base plus int16 deltas; values too
+       far from their block's base are kept on the side. */
+    class DeltaArray {
+    public:
+        void assign(const std::vector<unsigned int> &values);
+        void clear();
+        unsigned int operator[](size_t i) const {
+            int16_t d = deltas_[i];
+            if (d == WIDE) return wide_.find((uint32_t) i)->second;
+            return bases_[i / BLOCK] + d;
+        }
+    private:
+        static const int16_t WIDE = -32768;
+        std::vector<unsigned int> bases_;
+        std::vector<int16_t> deltas_;
+        std::map<uint32_t, unsigned int> wide_;
+    };
+
+    /* Rows per block, for the delta bases and the end-address bound */
+    static const size_t BLOCK = 16;
+    static const uint32_t WIDE_LENGTH = 0xffffffffU;
+
+    void finalize() const;
+    Row row(size_t i) const;
+    Offset rowEnd(size_t i) const;
+    size_t upperBound(Offset addr) const;
+    void containing(Offset addr, std::vector<size_t> &rows) const;
+    void buildLineOrder() const;
+    bool rowBefore(uint32_t r, unsigned int file, unsigned int line) const;
+    bool rowAfter(uint32_t r, unsigned int file, unsigned int line) const;
+    void fileIndices(const std::string &file, std::vector<unsigned> &indices) const;
+    std::pair<const_line_info_iterator, const_line_info_iterator>
+        lineRange(const std::vector<unsigned> &indices, unsigned int lineNo) const;
+    Statement_t materialize(size_t i) const;
+    unsigned int fileIndex(const std::string &file);
+
+    mutable dyn_mutex lock_;
+    mutable std::vector<Row> pending_;
+
+    mutable std::vector<Offset> starts_;
+    mutable std::vector<uint32_t> lengths_;
+    mutable std::map<uint32_t, Offset> wide_ends_;
+    mutable std::vector<unsigned int> files_;
+    mutable DeltaArray lines_;
+    mutable DeltaArray columns_;
+    /* Largest end address over blocks [0, b]; bounds the backward scan
+       for rows that overlap an address */
+    mutable std::vector<Offset> block_max_end_;
+    /* Row numbers sorted by (file, line, address); built on demand and
+       replaced, not modified, so by-source iterators can share it */
+    mutable boost::shared_ptr<std::vector<uint32_t> > by_line_;
+
+    mutable std::deque<Statement> statements_;
+    /* Keyed on row contents so a merge does not orphan them */
+    mutable std::map<Row, Statement_t> materialized_;
 };
 
 
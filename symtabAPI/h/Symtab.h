@@ -452,7 +452,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool changeAggregateOffset(Aggregate *agg, Offset oldOffset, Offset newOffset);
    bool deleteAggregate(Aggregate *agg);
 
-   bool addFunctionRange(FunctionBase *fbase, Dyninst::Offset next_start);
+   bool addFunctionRange(FunctionBase *fbase, Dyninst::Offset next_start,
+                         std::vector<FuncRange *> &franges);
 
    // Used by binaryEdit.C...
  public:
@@ -557,9 +558,27 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
        by_name_t by_pretty;
        by_name_t by_typed;
 
+       // In lazy mode the name indices, and the demangling they need,
+       // are deferred until the first name lookup.
+       bool lazy_names;
+       boost::atomic<bool> names_built;
+       // Held exclusively by build_name_indices, and shared by inserts
+       // made before it runs
+       dyn_rwlock names_lock;
+
+       indexed_symbols() : lazy_names(false), names_built(true) {}
+
        // Only inserts if not present. Returns whether it inserted.
        bool insert(Symbol* s);
 
+       // Defers the name indices for symbols inserted from now on.
+       void set_lazy_names(bool lazy);
+
+       // Builds any deferred name indices. Safe to use in parallel.
+       void build_name_indices();
+
+       void insert_names(Symbol* s);
+
        // Clears the table. Do not use in parallel.
        void clear();
 
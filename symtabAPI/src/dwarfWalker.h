@@ -75,20 +75,35 @@ protected:
     Dwarf* dbg() { return dbg_; }
 
     Module *& mod() { return mod_; } 
-    typeCollection *tc() { return typeCollection::getModTypeCollection(mod()); }
+    // tc() is hit for nearly every DIE; remember the collection for the
+    // current module instead of going through the global
+    // fileToTypesMap each time.
+    typeCollection *tc() {
+        if (mod() != tc_mod_) {
+            tc_ = typeCollection::getModTypeCollection(mod());
+            tc_mod_ = mod();
+        }
+        return tc_;
+    }
 
 private:
     Module *mod_;
     Dwarf* dbg_;
+    Module *tc_mod_;
+    typeCollection *tc_;
 public:
     DwarfParseActions(Symtab* s, Dwarf* d) :
         mod_(NULL),
         dbg_(d),
+        tc_mod_(NULL),
+        tc_(NULL),
         symtab_(s)
 {}
     DwarfParseActions(const DwarfParseActions& o) :
             mod_(o.mod_),
             dbg_(o.dbg_),
+            tc_mod_(o.tc_mod_),
+            tc_(o.tc_),
             c(o.c), symtab_(o.symtab_)
             {
             }
@@ -252,7 +267,9 @@ public:
             compile_offset(o.compile_offset),
             info_type_ids_(o.info_type_ids_),
             types_type_ids_(o.types_type_ids_),
-            sig8_type_ids_(o.sig8_type_ids_) {}
+            sig8_type_ids_(o.sig8_type_ids_),
+            next_type_id_(0),
+            last_type_id_(0) {}
 
     virtual ~DwarfWalker();
 
@@ -444,6 +461,12 @@ private:
     void findAllSig8Types();
     bool findSig8Type(Dwarf_Sig8 * signature, boost::shared_ptr<Type>&type);
     unsigned int getNextTypeId();
+
+    // Type ids are handed out from a block reserved from the global
+    // counter, so parallel walkers don't all bounce one atomic per type.
+    // [next_type_id_, last_type_id_) is the unused part of the block.
+    unsigned int next_type_id_;
+    unsigned int last_type_id_;
 protected:
     virtual void setFuncReturnType();
 
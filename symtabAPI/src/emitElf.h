@@ -284,6 +284,25 @@ namespace Dyninst {
             std::vector<void*> buffers;
             char* allocate_buffer(size_t);
 
+            // Streaming output (SYMTAB_STREAM_REWRITE): sections we don't
+            // touch are left out of the libelf image and copied straight
+            // from the input file into the output once libelf is done.
+            struct StreamedSection {
+                Elf_Scn *scn;
+                Elf_Off srcOffset;
+                Elf_Off dstOffset;
+                Elf_Off size;
+                Elf_Word type;
+                // Where sh_type lands in the output; libelf's handles
+                // are gone by the time we patch it
+                Elf_Off typeOffset;
+            };
+            bool streamSections;
+            std::vector<StreamedSection> streamed;
+            bool canStreamSections();
+            void hideStreamedSections();
+            bool writeStreamedSections(int fd);
+
         };
         extern template class emitElf<ElfTypes32>;
         extern template class emitElf<ElfTypes64>;